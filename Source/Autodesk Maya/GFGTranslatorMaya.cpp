@@ -539,11 +539,7 @@ bool GFGTranslator::ImportMesh(MObject& meshTransform,
 
 		// Add Position
 		vertexPositions.append(MPoint(pos[0], pos[1], pos[2]));
-		uint64_t stride = headerComp[componentId].stride;
-		if(stride == 0)
-		{
-			stride = GFGDataTypeByteSize[static_cast<uint32_t>(headerComp[componentId].dataType)];
-		}
+		uint64_t stride = GFGComponentStride(headerComp[componentId]);
 		meshPosPtr += stride;
 	}
 	// This is all fundementasally Required By the Vertex
@@ -586,11 +582,7 @@ bool GFGTranslator::ImportMesh(MObject& meshTransform,
 				// Add UV
 				UVSets.back().u.append(float(uv[0]));
 				UVSets.back().v.append(float(uv[1]));
-				uint64_t stride = headerComp[uvComponentIDs.back()].stride;
-				if(stride == 0)
-				{
-					stride = GFGDataTypeByteSize[static_cast<uint32_t>(headerComp[uvComponentIDs.back()].dataType)];
-				}
+				uint64_t stride = GFGComponentStride(headerComp[uvComponentIDs.back()]);
 				uvPosPtr += stride;
 			}
 			uvPosition = std::find_if((uvPosition + 1), headerComp.end(), findUVFunc);
@@ -630,11 +622,7 @@ bool GFGTranslator::ImportMesh(MObject& meshTransform,
 
 				// Add Normal
 				normals.append(MVector(normal[0], normal[1], normal[2]));
-				uint64_t stride = headerComp[normalComponentID].stride;
-				if(stride == 0)
-				{
-					stride = GFGDataTypeByteSize[static_cast<uint32_t>(headerComp[normalComponentID].dataType)];
-				}
+				uint64_t stride = GFGComponentStride(headerComp[normalComponentID]);
 				normalPosPtr += stride;
 			}
 		}
@@ -672,11 +660,7 @@ bool GFGTranslator::ImportMesh(MObject& meshTransform,
 
 				// Add Color
 				colors.append(MColor(static_cast<float>(color[0]), static_cast<float>(color[1]), static_cast<float>(color[2])));
-				uint64_t stride = headerComp[colorComponentID].stride;
-				if(stride == 0)
-				{
-					stride = GFGDataTypeByteSize[static_cast<uint32_t>(headerComp[colorComponentID].dataType)];
-				}
+				uint64_t stride = GFGComponentStride(headerComp[colorComponentID]);
 				colorPosPtr += stride;
 			}
 		}
@@ -796,11 +780,7 @@ bool GFGTranslator::ImportMesh(MObject& meshTransform,
 							return false;
 						}
 						weights.back().setLength(maxInf);
-						uint64_t stride = headerComp[weightComponentID].stride;
-						if(stride == 0)
-						{
-							stride = GFGDataTypeByteSize[static_cast<uint32_t>(headerComp[weightComponentID].dataType)];
-						}
+						uint64_t stride = GFGComponentStride(headerComp[weightComponentID]);
 						weightPosPtr += stride;
 					}
 				}
@@ -839,11 +819,7 @@ bool GFGTranslator::ImportMesh(MObject& meshTransform,
 							return false;
 						}
 						weightIndices.back().setLength(maxInf);
-						uint64_t stride = headerComp[weightIndexComponentID].stride;
-						if(stride == 0)
-						{
-							stride = GFGDataTypeByteSize[static_cast<uint32_t>(headerComp[weightIndexComponentID].dataType)];
-						}
+						uint64_t stride = GFGComponentStride(headerComp[weightIndexComponentID]);
 						weightIndexPosPtr += stride;
 					}
 				}
@@ -2555,8 +2531,8 @@ MStatus GFGTranslator::ExportMesh(const GFGTransform& transform,
 							parentIndex,
 							currentComponentArray,
 							currentMeshHeader,
-							vertexDataConcat,
-							&indexDataConcat,
+							std::move(vertexDataConcat),
+							std::move(indexDataConcat),
 							&materialPairings,
 							(gfgOptions.skelOn &&
 							 hasWeights &&
@@ -2567,8 +2543,8 @@ MStatus GFGTranslator::ExportMesh(const GFGTransform& transform,
 		gfgExporter.AddMesh(parentIndex,
 							currentComponentArray,
 							currentMeshHeader,
-							vertexDataConcat,
-							&indexDataConcat,
+							std::move(vertexDataConcat),
+							std::move(indexDataConcat),
 							&materialPairings,
 							(gfgOptions.skelOn &&
 							 hasWeights &&
@@ -2684,10 +2660,10 @@ MStatus GFGTranslator::WriteReferencedMaterials(std::vector<uint32_t>& materialI
 				if(gfgOptions.matOn)
 				{
 					gfgExporter.AddMaterial(material.headerCore.logic,
-											&material.textureList,
-											&material.uniformList,
-											&textureData,
-											&uniformData);
+											material.textureList,
+											material.uniformList,
+											std::move(textureData),
+											std::move(uniformData));
 				}
 			}
 			else
@@ -2868,7 +2844,7 @@ MStatus GFGTranslator::ExportSkeleton(const MDagPath& root, bool inSelectionList
 								 gfgOptions.quatLayout,
 								 skelId,
 								 anim.KeyCount(),
-								 data);
+								 std::move(data));
 
 		////DEBUG
 		//anim.PrintFormattedData();
@@ -0,0 +1,322 @@
+#include "GFGChecksum.h"
+#include <cassert>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+	#define GFG_CRC_X86
+	#include <nmmintrin.h>
+	#if defined(_MSC_VER) && !defined(__clang__)
+		#include <intrin.h>
+		#define GFG_TARGET_CRC
+	#else
+		#define GFG_TARGET_CRC __attribute__((target("sse4.2")))
+	#endif
+#elif defined(__ARM_FEATURE_CRC32)
+	#define GFG_CRC_ARM
+	#include <arm_acle.h>
+	#define GFG_TARGET_CRC
+#endif
+
+namespace
+{
+	// Reflected Castagnoli polynomial
+	constexpr uint32_t Crc32CPoly = 0x82F63B78;
+
+	// Slicing-by-8 tables
+	struct Crc32CTables
+	{
+		uint32_t	t[8][256];
+
+		Crc32CTables()
+		{
+			for(uint32_t n = 0; n < 256; n++)
+			{
+				uint32_t crc = n;
+				for(int k = 0; k < 8; k++)
+					crc = (crc & 1) ? (crc >> 1) ^ Crc32CPoly : crc >> 1;
+				t[0][n] = crc;
+			}
+			for(uint32_t n = 0; n < 256; n++)
+				for(int k = 1; k < 8; k++)
+					t[k][n] = (t[k - 1][n] >> 8) ^ t[0][t[k - 1][n] & 0xFF];
+		}
+	};
+
+	const Crc32CTables& Tables()
+	{
+		static const Crc32CTables tables;
+		return tables;
+	}
+
+	uint32_t Crc32CSoftware(const uint8_t data[], size_t size, uint32_t crc)
+	{
+		const Crc32CTables& tables = Tables();
+		const auto& t = tables.t;
+
+		crc = ~crc;
+		for(; size >= 8; data += 8, size -= 8)
+		{
+			uint64_t v;
+			std::memcpy(&v, data, sizeof(uint64_t));
+			v ^= crc;
+			crc = t[7][v & 0xFF] ^ t[6][(v >> 8) & 0xFF] ^
+				  t[5][(v >> 16) & 0xFF] ^ t[4][(v >> 24) & 0xFF] ^
+				  t[3][(v >> 32) & 0xFF] ^ t[2][(v >> 40) & 0xFF] ^
+				  t[1][(v >> 48) & 0xFF] ^ t[0][v >> 56];
+		}
+		for(; size > 0; data++, size--)
+			crc = t[0][(crc ^ *data) & 0xFF] ^ (crc >> 8);
+		return ~crc;
+	}
+
+	// Polynomial arithmetic modulo the CRC polynomial (reflected)
+	// used to combine checksums without touching the data
+	uint32_t MultModP(uint32_t a, uint32_t b)
+	{
+		uint32_t m = 1u << 31;
+		uint32_t p = 0;
+		for(;;)
+		{
+			if(a & m)
+			{
+				p ^= b;
+				if((a & (m - 1)) == 0) break;
+			}
+			m >>= 1;
+			b = (b & 1) ? (b >> 1) ^ Crc32CPoly : b >> 1;
+		}
+		return p;
+	}
+
+	struct PowerTable
+	{
+		// x^(2^n) mod P
+		uint32_t	x2n[32];
+
+		PowerTable()
+		{
+			uint32_t p = 1u << 30;		// x^1
+			x2n[0] = p;
+			for(int n = 1; n < 32; n++)
+				x2n[n] = p = MultModP(p, p);
+		}
+	};
+
+	// x^(n * 2^k) mod P
+	uint32_t X2NModP(uint64_t n, uint32_t k)
+	{
+		static const PowerTable powers;
+		uint32_t p = 1u << 31;			// x^0
+		while(n)
+		{
+			if(n & 1) p = MultModP(powers.x2n[k & 31], p);
+			n >>= 1;
+			k++;
+		}
+		return p;
+	}
+
+	#if defined(GFG_CRC_X86) || defined(GFG_CRC_ARM)
+	#ifdef GFG_CRC_X86
+	GFG_TARGET_CRC inline uint32_t Step8(uint32_t crc, uint8_t v) { return _mm_crc32_u8(crc, v); }
+	GFG_TARGET_CRC inline uint32_t Step64(uint32_t crc, uint64_t v) { return static_cast<uint32_t>(_mm_crc32_u64(crc, v)); }
+
+	bool HasHardwareCrc()
+	{
+		#if defined(_MSC_VER) && !defined(__clang__)
+			int info[4];
+			__cpuid(info, 1);
+			return (info[2] & (1 << 20)) != 0;
+		#else
+			return __builtin_cpu_supports("sse4.2");
+		#endif
+	}
+	#else
+	inline uint32_t Step8(uint32_t crc, uint8_t v) { return __crc32cb(crc, v); }
+	inline uint32_t Step64(uint32_t crc, uint64_t v) { return __crc32cd(crc, v); }
+
+	bool HasHardwareCrc() { return true; }
+	#endif
+
+	// CRC instruction has a latency of ~3 cycles but a throughput of 1,
+	// large buffers are processed as three independent lanes which are
+	// combined afterwards
+	constexpr size_t LaneSize = 4096;
+
+	GFG_TARGET_CRC
+	uint32_t Crc32CHardware(const uint8_t data[], size_t size, uint32_t crc)
+	{
+		static const uint32_t laneShift = X2NModP(LaneSize, 3);
+
+		for(; size >= LaneSize * 3; data += LaneSize * 3, size -= LaneSize * 3)
+		{
+			uint32_t a = ~crc;
+			uint32_t b = ~0u;
+			uint32_t c = ~0u;
+			for(size_t i = 0; i < LaneSize; i += 8)
+			{
+				uint64_t va, vb, vc;
+				std::memcpy(&va, data + i, sizeof(uint64_t));
+				std::memcpy(&vb, data + LaneSize + i, sizeof(uint64_t));
+				std::memcpy(&vc, data + LaneSize * 2 + i, sizeof(uint64_t));
+				a = Step64(a, va);
+				b = Step64(b, vb);
+				c = Step64(c, vc);
+			}
+			crc = MultModP(laneShift, ~a) ^ ~b;
+			crc = MultModP(laneShift, crc) ^ ~c;
+		}
+
+		crc = ~crc;
+		for(; size >= 8; data += 8, size -= 8)
+		{
+			uint64_t v;
+			std::memcpy(&v, data, sizeof(uint64_t));
+			crc = Step64(crc, v);
+		}
+		for(; size > 0; data++, size--)
+			crc = Step8(crc, *data);
+		return ~crc;
+	}
+	#endif
+
+	using Crc32CFunc = uint32_t(*)(const uint8_t[], size_t, uint32_t);
+
+	Crc32CFunc SelectCrc32C()
+	{
+		#if defined(GFG_CRC_X86) || defined(GFG_CRC_ARM)
+		if(HasHardwareCrc()) return Crc32CHardware;
+		#endif
+		return Crc32CSoftware;
+	}
+}
+
+uint32_t GFGCrc32C(const uint8_t data[], size_t size, uint32_t crc)
+{
+	static const Crc32CFunc func = SelectCrc32C();
+	return func(data, size, crc);
+}
+
+uint32_t GFGCrc32CCombine(uint32_t crcA, uint32_t crcB, uint64_t sizeB)
+{
+	return MultModP(X2NModP(sizeB, 3), crcA) ^ crcB;
+}
+
+GFGChecksumTable::GFGChecksumTable()
+	: meshCount(0)
+	, materialCount(0)
+	, animationCount(0)
+	, headerChecksum(0)
+{}
+
+GFGChecksumTable::GFGChecksumTable(uint32_t meshCount,
+								   uint32_t materialCount,
+								   uint32_t animationCount)
+	: meshCount(meshCount)
+	, materialCount(materialCount)
+	, animationCount(animationCount)
+	, headerChecksum(0)
+	, blockChecksums(static_cast<size_t>(meshCount) * 2 +
+					 static_cast<size_t>(materialCount) * 2 +
+					 animationCount, 0)
+{}
+
+uint32_t GFGChecksumTable::Slot(GFGBlockType type, uint32_t index) const
+{
+	switch(type)
+	{
+		case GFGBlockType::MESH_VERTEX:
+			assert(index < meshCount);
+			return index;
+		case GFGBlockType::MESH_INDEX:
+			assert(index < meshCount);
+			return meshCount + index;
+		case GFGBlockType::MATERIAL_TEXTURE:
+			assert(index < materialCount);
+			return meshCount * 2 + index;
+		case GFGBlockType::MATERIAL_UNIFORM:
+			assert(index < materialCount);
+			return meshCount * 2 + materialCount + index;
+		case GFGBlockType::ANIMATION_KEYFRAME:
+			assert(index < animationCount);
+			return meshCount * 2 + materialCount * 2 + index;
+	}
+	return 0;
+}
+
+size_t GFGChecksumTable::SerializedSize(uint32_t meshCount,
+										uint32_t materialCount,
+										uint32_t animationCount)
+{
+	size_t blockCount = static_cast<size_t>(meshCount) * 2 +
+						static_cast<size_t>(materialCount) * 2 +
+						animationCount;
+	return sizeof(uint32_t) * (2 + blockCount);
+}
+
+void GFGChecksumTable::Serialize(std::vector<uint8_t>& data) const
+{
+	uint32_t blockCount = BlockCount();
+	data.resize(SerializedSize(meshCount, materialCount, animationCount));
+	std::memcpy(data.data(), &blockCount, sizeof(uint32_t));
+	std::memcpy(data.data() + sizeof(uint32_t), &headerChecksum, sizeof(uint32_t));
+	std::memcpy(data.data() + sizeof(uint32_t) * 2, blockChecksums.data(),
+				blockChecksums.size() * sizeof(uint32_t));
+}
+
+bool GFGChecksumTable::Load(GFGSpan<const uint8_t> data,
+							uint32_t meshCount,
+							uint32_t materialCount,
+							uint32_t animationCount)
+{
+	Clear();
+	if(data.size() != SerializedSize(meshCount, materialCount, animationCount))
+		return false;
+
+	*this = GFGChecksumTable(meshCount, materialCount, animationCount);
+	uint32_t blockCount;
+	std::memcpy(&blockCount, data.data(), sizeof(uint32_t));
+	if(blockCount != blockChecksums.size())
+	{
+		Clear();
+		return false;
+	}
+	std::memcpy(&headerChecksum, data.data() + sizeof(uint32_t), sizeof(uint32_t));
+	std::memcpy(blockChecksums.data(), data.data() + sizeof(uint32_t) * 2,
+				blockChecksums.size() * sizeof(uint32_t));
+	return true;
+}
+
+void GFGChecksumTable::Clear()
+{
+	meshCount = 0;
+	materialCount = 0;
+	animationCount = 0;
+	headerChecksum = 0;
+	blockChecksums.clear();
+}
+
+uint32_t GFGChecksumTable::BlockCount() const
+{
+	return static_cast<uint32_t>(blockChecksums.size());
+}
+
+uint32_t GFGChecksumTable::HeaderChecksum() const
+{
+	return headerChecksum;
+}
+
+uint32_t GFGChecksumTable::BlockChecksum(GFGBlockType type, uint32_t index) const
+{
+	return blockChecksums[Slot(type, index)];
+}
+
+void GFGChecksumTable::SetHeaderChecksum(uint32_t checksum)
+{
+	headerChecksum = checksum;
+}
+
+void GFGChecksumTable::SetBlockChecksum(GFGBlockType type, uint32_t index, uint32_t checksum)
+{
+	blockChecksums[Slot(type, index)] = checksum;
+}
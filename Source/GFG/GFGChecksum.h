@@ -0,0 +1,87 @@
+/**
+
+GFGCrc32C Function
+GFGCrc32CCombine Function
+GFGChecksumTable Class
+
+CRC32C (Castagnoli) checksums of the header and the data blocks.
+Hardware CRC instructions are used when available (SSE4.2 on x86,
+selected at runtime; ARMv8 CRC extension when the compiler targets it),
+otherwise a slicing-by-8 table implementation is used.
+
+Checksums can be chained (checksum of the previous data is given as "crc")
+or combined (checksum of the concatenated data from the checksums of the
+parts), latter is used to checksum a single large block on multiple threads.
+
+Table is stored in the header as GFGExtensionTag::CHECKSUMS extension
+(GFGFileExporter::EnableChecksums) and it is always the last section
+of the header. Header checksum covers the whole header except the
+table payload.
+
+Serialized Layout
+	uint32_t		blockCount;
+	uint32_t		headerChecksum;
+	uint32_t		blockChecksums[blockCount];
+
+Blocks are ordered as mesh vertex blocks, mesh index blocks, material
+texture blocks, material uniform blocks then animation keyframe blocks.
+
+For License refer to:
+https://github.com/yalcinerbora/GFGFileFormat/blob/master/LICENSE
+*/
+
+#ifndef __GFG_CHECKSUM_H__
+#define __GFG_CHECKSUM_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "GFGEnumerations.h"
+#include "GFGSpan.h"
+
+uint32_t GFGCrc32C(const uint8_t data[], size_t size, uint32_t crc = 0);
+// Checksum of A followed by B ("sizeB" is the byte size of B)
+uint32_t GFGCrc32CCombine(uint32_t crcA, uint32_t crcB, uint64_t sizeB);
+
+class GFGChecksumTable
+{
+	private:
+		uint32_t					meshCount;
+		uint32_t					materialCount;
+		uint32_t					animationCount;
+
+		uint32_t					headerChecksum;
+		std::vector<uint32_t>		blockChecksums;
+
+		uint32_t					Slot(GFGBlockType, uint32_t index) const;
+
+	protected:
+	public:
+		// Constructors & Destructor
+									GFGChecksumTable();
+									GFGChecksumTable(uint32_t meshCount,
+													 uint32_t materialCount,
+													 uint32_t animationCount);
+									~GFGChecksumTable() = default;
+
+		// Creation
+		static size_t				SerializedSize(uint32_t meshCount,
+												   uint32_t materialCount,
+												   uint32_t animationCount);
+		void						Serialize(std::vector<uint8_t>& data) const;
+		// Returns false if the data is corrupted or does not match the block counts
+		bool						Load(GFGSpan<const uint8_t> data,
+										 uint32_t meshCount,
+										 uint32_t materialCount,
+										 uint32_t animationCount);
+		void						Clear();
+
+		// Access
+		uint32_t					BlockCount() const;
+		uint32_t					HeaderChecksum() const;
+		uint32_t					BlockChecksum(GFGBlockType, uint32_t index) const;
+
+		void						SetHeaderChecksum(uint32_t);
+		void						SetBlockChecksum(GFGBlockType, uint32_t index, uint32_t);
+};
+#endif //__GFG_CHECKSUM_H__
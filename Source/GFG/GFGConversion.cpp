@@ -373,13 +373,8 @@ void GFGConversions::UIntToUInt8_4_4(uint8_t dataOut[],
 
 void GFGConversions::DoubleToHalfV(uint8_t dataOut[], size_t dataCapacity, const double data[], size_t dataAmount)
 {
-	uint16_t temp;
 	assert(dataCapacity >= sizeof(half_float::half) * dataAmount);
-	for(size_t i = 0; i < dataAmount; i++)
-	{
-		temp = GFGConversions::DoubleToHalf(data[i]);
-		std::memcpy(dataOut + i * sizeof(uint16_t), &temp, sizeof(uint16_t));
-	}
+	GFGConversions::DoubleToHalfStream(dataOut, data, dataAmount);
 }
 
 void GFGConversions::DoubleToFloatV(uint8_t dataOut[], size_t dataCapacity, const double data[], size_t dataAmount)
@@ -527,12 +522,7 @@ void GFGConversions::IntToInt32V(uint8_t dataOut[], size_t dataCapacity, const i
 void GFGConversions::HalfToDoubleV(double dataOut[], size_t dataCapacity, const uint8_t dataIn[], size_t dataAmount)
 {
 	assert(dataCapacity >= sizeof(half_float::half) * dataAmount);
-	for(unsigned int i = 0; i < dataAmount; i++)
-	{
-		half_float::half half;
-		std::memcpy(&half, dataIn + i * sizeof(half_float::half), sizeof(half_float::half));
-		dataOut[i] = static_cast<double>(static_cast<float>(half));
-	}
+	GFGConversions::HalfToDoubleStream(dataOut, dataIn, dataAmount);
 }
 
 void GFGConversions::FloatToDoubleV(double dataOut[], size_t dataCapacity, const uint8_t dataIn[], size_t dataAmount)
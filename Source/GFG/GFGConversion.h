@@ -5,6 +5,10 @@ GFGConversions Namespace
 Used to convert various GFGDataType to their "meta" data type
 for real numbers its "double" and for integers its "int"
 
+Stream functions convert whole (strided) arrays between data types
+in blocks using SIMD kernels (AVX2/F16C on x86 selected at runtime, NEON on ARM64)
+Half stream functions are bit-exact with the scalar FloatToHalf/DoubleToHalf
+
 For License refer to:
 https://github.com/yalcinerbora/GFGFileFormat/blob/master/LICENSE
 */
@@ -155,5 +159,24 @@ namespace GFGConversions
 										  size_t dataCapacity,
 										  const uint8_t data[]);
 
+	// Stream Conversion
+	// Converts "count" elements of "srcType" to "dstType", i'th element is read from
+	// "src + i * srcStride" and written to "dst + i * dstStride".
+	// Destination should be HALF_N, FLOAT_N or DOUBLE_N type with the same component count
+	// as the source; source can be any float, integer or (u)norm type (packed
+	// and custom types are not supported). Same types are copied.
+	// Returns false if conversion is not supported
+	bool				IsStreamConvertible(GFGDataType dstType, GFGDataType srcType);
+	bool				ConvertStream(uint8_t dst[], size_t dstStride, GFGDataType dstType,
+									  const uint8_t src[], size_t srcStride, GFGDataType srcType,
+									  size_t count);
+
+	// Bulk Half Conversion
+	// Converts "count" packed values (half data does not need to be aligned)
+	void				FloatToHalfStream(uint8_t dst[], const float src[], size_t count);
+	void				DoubleToHalfStream(uint8_t dst[], const double src[], size_t count);
+	void				HalfToFloatStream(float dst[], const uint8_t src[], size_t count);
+	void				HalfToDoubleStream(double dst[], const uint8_t src[], size_t count);
+
 	// TODO Add mode Unpacking Modes
 };
@@ -8,6 +8,7 @@ GFGTopology Enumeration
 GFGDirection Enumeration
 GFGStringType Enumeration
 GFGMaterialLogic Enumeration
+GFGBlockType Enumeration
 
 Various enumerations used by the GFGHeader.
 
@@ -489,4 +490,14 @@ enum class GFGMaterialLogic : uint32_t
 
 	//TODO: Add Major Programs shaders also (like blender, 3dmax)
 };
+
+// Data blocks that reside in the data segment
+enum class GFGBlockType
+{
+	MESH_VERTEX,
+	MESH_INDEX,
+	MATERIAL_TEXTURE,
+	MATERIAL_UNIFORM,
+	ANIMATION_KEYFRAME
+};
 #endif //__GFG_ENUMERATIONS_H__
\ No newline at end of file
@@ -1,6 +1,16 @@
 #include "GFGFileExporter.h"
+#include "GFGSpatialIndex.h"
+#include "GFGChecksum.h"
+#include "GFGThreadPool.h"
+#include "GFGFileLoader.h"
 #include <cassert>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <map>
+#include <memory>
 
 // Constructors & Destructor
 GFGFileWriterSTL::GFGFileWriterSTL(std::ofstream& fileWriter)
@@ -12,20 +22,184 @@ void GFGFileWriterSTL::Write(const uint8_t buffer[], size_t writeAmount)
 	writer.write(reinterpret_cast<const char*>(buffer), writeAmount);
 }
 
-// File Writer
-GFGAddMeshResult GFGFileExporter::AddMesh(const GFGTransform& transform,
-										uint32_t parent,
-										const std::vector<GFGVertexComponent>& headerComponent,
-										const GFGMeshHeaderCore& headerBase,
-										const std::vector<uint8_t>& vertexData,
-										const std::vector<uint8_t>* indexData,
-										const std::vector<GFGMeshMatPair>* materialPairings,
-										const std::vector<GFGMeshSkelPair>* skeletonPairings)
+bool GFGFileWriterSTL::MovePtrAbs(size_t absLocation)
 {
-	// Add transform to the hierarcy
-	gfgHeader.transformData.transforms.push_back(transform);
-	uint32_t transformID = static_cast<uint32_t>(gfgHeader.transformData.transforms.size() - 1);
+	writer.seekp(absLocation);
+	return !writer.fail();
+}
+
+bool GFGFileWriterI::WriteAt(const uint8_t buffer[], size_t writeAmount, size_t absLocation)
+{
+	// Writers that can not seek can not write positionally
+	if(!MovePtrAbs(absLocation)) return false;
+	Write(buffer, writeAmount);
+	return true;
+}
 
+bool GFGFileWriterI::WriteVectored(const GFGWriteVec vectors[], size_t vectorCount)
+{
+	for(size_t i = 0; i < vectorCount; i++)
+		Write(vectors[i].buffer, vectors[i].size);
+	return true;
+}
+
+namespace
+{
+	// Header reservation of the streaming mode is zero filled with this granularity
+	constexpr size_t ZeroFillSize = 64 * 1024;
+
+	uint64_t AlignUp(uint64_t value, uint64_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	// Forwards the writes and accumulates their checksum
+	class GFGFileWriterChecksum : public GFGFileWriterI
+	{
+		private:
+			GFGFileWriterI&		writer;
+			uint32_t			checksum;
+
+		protected:
+		public:
+			// Constructors & Destructor
+						GFGFileWriterChecksum(GFGFileWriterI& writer)
+							: writer(writer)
+							, checksum(0)
+						{}
+
+			void		Write(const uint8_t buffer[], size_t writeAmount) override
+			{
+				checksum = GFGCrc32C(buffer, writeAmount, checksum);
+				writer.Write(buffer, writeAmount);
+			}
+			uint32_t	Checksum() const { return checksum; }
+	};
+
+	// Serializes to a contiguous buffer
+	class GFGFileWriterMemory : public GFGFileWriterI
+	{
+		public:
+			std::vector<uint8_t>	buffer;
+
+			void		Write(const uint8_t data[], size_t writeAmount) override
+			{
+				buffer.insert(buffer.end(), data, data + writeAmount);
+			}
+	};
+
+	struct WriteChunk
+	{
+		const uint8_t*	data;
+		uint64_t		size;
+		uint64_t		location;
+	};
+
+	struct WriteState
+	{
+		std::atomic<size_t>	remainingChunks;
+		std::atomic<bool>	failed;
+		std::promise<void>	promise;
+	};
+
+	// Data of a block type is written back to back, checksums are calculated
+	// over the concatenated data using the block sizes of the header
+	// (data entries do not need to match the blocks one to one)
+	void StreamChecksums(GFGChecksumTable& table, GFGBlockType type,
+						 const std::vector<GFGExportData>& data,
+						 const std::vector<uint64_t>& blockSizes)
+	{
+		size_t vectorIndex = 0;
+		size_t vectorOffset = 0;
+		for(uint32_t i = 0; i < static_cast<uint32_t>(blockSizes.size()); i++)
+		{
+			uint32_t checksum = 0;
+			uint64_t remaining = blockSizes[i];
+			while(remaining > 0 && vectorIndex < data.size())
+			{
+				const GFGExportData& v = data[vectorIndex];
+				size_t size = static_cast<size_t>(std::min<uint64_t>(remaining, v.size() - vectorOffset));
+				checksum = GFGCrc32C(v.data() + vectorOffset, size, checksum);
+				remaining -= size;
+				vectorOffset += size;
+				if(vectorOffset == v.size())
+				{
+					vectorIndex++;
+					vectorOffset = 0;
+				}
+			}
+			table.SetBlockChecksum(type, i, checksum);
+		}
+	}
+}
+
+// Export Data
+GFGExportData::GFGExportData(std::vector<uint8_t>&& data)
+	: owned(std::move(data))
+	, view(owned)
+{}
+
+GFGExportData::GFGExportData(GFGSpan<const uint8_t> borrowed)
+	: owned()
+	, view(borrowed)
+{}
+
+GFGExportData::GFGExportData(const GFGExportData& other)
+	: owned(other.owned)
+	, view((other.IsBorrowed() || other.IsReserved()) ? other.view : GFGSpan<const uint8_t>(owned))
+{}
+
+GFGExportData& GFGExportData::operator=(const GFGExportData& other)
+{
+	if(this == &other) return *this;
+	owned = other.owned;
+	view = (other.IsBorrowed() || other.IsReserved()) ? other.view : GFGSpan<const uint8_t>(owned);
+	return *this;
+}
+
+GFGExportData GFGExportData::Reserved(size_t size)
+{
+	return GFGExportData(GFGSpan<const uint8_t>(nullptr, size));
+}
+
+const uint8_t* GFGExportData::data() const
+{
+	return view.data();
+}
+
+size_t GFGExportData::size() const
+{
+	return view.size();
+}
+
+bool GFGExportData::IsBorrowed() const
+{
+	return view.data() != owned.data();
+}
+
+bool GFGExportData::IsReserved() const
+{
+	return view.data() == nullptr && view.size() != 0;
+}
+
+// Constructors & Destructor
+GFGFileExporter::GFGFileExporter()
+	: arena(DefaultArenaChunkSize)
+{}
+
+GFGFileExporter::GFGFileExporter(std::pmr::memory_resource* upstream,
+								 size_t arenaChunkSize)
+	: arena(arenaChunkSize, upstream)
+{}
+
+// File Writer
+uint32_t GFGFileExporter::PushMesh(const std::vector<GFGVertexComponent>& headerComponent,
+								   const GFGMeshHeaderCore& headerBase,
+								   GFGExportData&& vertexData,
+								   GFGExportData&& indexData,
+								   const std::vector<GFGMeshMatPair>* materialPairings,
+								   const std::vector<GFGMeshSkelPair>* skeletonPairings)
+{
 	// Add mesh
 	gfgHeader.meshes.emplace_back
 	(
@@ -37,10 +211,6 @@ GFGAddMeshResult GFGFileExporter::AddMesh(const GFGTransform& transform,
 	);
 	uint32_t meshID = static_cast<uint32_t>(gfgHeader.meshes.size() - 1);
 
-	// Add Scene Node
-	gfgHeader.sceneHierarchy.nodes.emplace_back(GFGNode {parent, transformID, meshID});
-	uint32_t nodeID = static_cast<uint32_t>(gfgHeader.sceneHierarchy.nodes.size() - 1);
-
 	// Add Pairings If Available
 	if(skeletonPairings)
 	{
@@ -70,9 +240,75 @@ GFGAddMeshResult GFGFileExporter::AddMesh(const GFGTransform& transform,
 	}
 
 	// Now Can Add Actual Data
-	meshData.emplace_back(vertexData);
-	if(indexData) meshIndexData.emplace_back(*indexData);
-	return {meshID, nodeID};
+	if(streamWriter)
+	{
+		StreamBlock(GFGBlockType::MESH_VERTEX, meshID, vertexData);
+		StreamBlock(GFGBlockType::MESH_INDEX, meshID, indexData);
+		return meshID;
+	}
+	meshData.emplace_back(std::move(vertexData));
+	meshIndexData.emplace_back(std::move(indexData));
+	return meshID;
+}
+
+GFGAddMeshResult GFGFileExporter::PushMeshNode(const GFGTransform& transform,
+											   uint32_t parent,
+											   uint32_t meshIndex)
+{
+	// Add transform to the hierarcy
+	gfgHeader.transformData.transforms.push_back(transform);
+	uint32_t transformID = static_cast<uint32_t>(gfgHeader.transformData.transforms.size() - 1);
+
+	// Add Scene Node
+	gfgHeader.sceneHierarchy.nodes.emplace_back(GFGNode {parent, transformID, meshIndex});
+	uint32_t nodeID = static_cast<uint32_t>(gfgHeader.sceneHierarchy.nodes.size() - 1);
+	return {meshIndex, nodeID};
+}
+
+GFGAddMeshResult GFGFileExporter::AddMesh(const GFGTransform& transform,
+										uint32_t parent,
+										const std::vector<GFGVertexComponent>& headerComponent,
+										const GFGMeshHeaderCore& headerBase,
+										const std::vector<uint8_t>& vertexData,
+										const std::vector<uint8_t>* indexData,
+										const std::vector<GFGMeshMatPair>* materialPairings,
+										const std::vector<GFGMeshSkelPair>* skeletonPairings)
+{
+	uint32_t meshID = PushMesh(headerComponent, headerBase,
+							   CopyData(vertexData),
+							   indexData ? CopyData(*indexData) : GFGExportData(),
+							   materialPairings, skeletonPairings);
+	return PushMeshNode(transform, parent, meshID);
+}
+
+GFGAddMeshResult GFGFileExporter::AddMesh(const GFGTransform& transform,
+										uint32_t parent,
+										const std::vector<GFGVertexComponent>& headerComponent,
+										const GFGMeshHeaderCore& headerBase,
+										std::vector<uint8_t>&& vertexData,
+										std::vector<uint8_t>&& indexData,
+										const std::vector<GFGMeshMatPair>* materialPairings,
+										const std::vector<GFGMeshSkelPair>* skeletonPairings)
+{
+	uint32_t meshID = PushMesh(headerComponent, headerBase,
+							   std::move(vertexData), std::move(indexData),
+							   materialPairings, skeletonPairings);
+	return PushMeshNode(transform, parent, meshID);
+}
+
+GFGAddMeshResult GFGFileExporter::AddMesh(const GFGTransform& transform,
+										uint32_t parent,
+										const std::vector<GFGVertexComponent>& headerComponent,
+										const GFGMeshHeaderCore& headerBase,
+										GFGSpan<const uint8_t> vertexData,
+										GFGSpan<const uint8_t> indexData,
+										const std::vector<GFGMeshMatPair>* materialPairings,
+										const std::vector<GFGMeshSkelPair>* skeletonPairings)
+{
+	uint32_t meshID = PushMesh(headerComponent, headerBase,
+							   vertexData, indexData,
+							   materialPairings, skeletonPairings);
+	return PushMeshNode(transform, parent, meshID);
 }
 
 uint32_t GFGFileExporter::AddMesh(uint32_t,
@@ -83,51 +319,61 @@ uint32_t GFGFileExporter::AddMesh(uint32_t,
 								  const std::vector<GFGMeshMatPair>* materialPairings,
 								  const std::vector<GFGMeshSkelPair>* skeletonPairings)
 {
-	// Add mesh
-	gfgHeader.meshes.emplace_back
-	(
-		GFGMeshHeader
-		{
-			headerBase,
-			std::vector<GFGVertexComponent>(headerComponent)
-		}
-	);
-	uint32_t meshID = static_cast<uint32_t>(gfgHeader.meshes.size() - 1);
+	return PushMesh(headerComponent, headerBase,
+					CopyData(vertexData),
+					indexData ? CopyData(*indexData) : GFGExportData(),
+					materialPairings, skeletonPairings);
+}
 
-	// Add Pairings If Available
-	if(skeletonPairings)
-	{
-		auto end = gfgHeader.meshSkeletonConnections.connections.end();
-		auto location = gfgHeader.meshSkeletonConnections.connections.insert(end,
-																			 skeletonPairings->begin(),
-																			 skeletonPairings->end());
-		// End invalid now re-end
-		end = gfgHeader.meshSkeletonConnections.connections.end();
-		for(auto i = location; i != end; i++)
-		{
-			i->meshIndex = meshID;
-		}
-	}
-	if(materialPairings)
+uint32_t GFGFileExporter::AddMesh(uint32_t,
+								  const std::vector<GFGVertexComponent>& headerComponent,
+								  const GFGMeshHeaderCore& headerBase,
+								  std::vector<uint8_t>&& vertexData,
+								  std::vector<uint8_t>&& indexData,
+								  const std::vector<GFGMeshMatPair>* materialPairings,
+								  const std::vector<GFGMeshSkelPair>* skeletonPairings)
+{
+	return PushMesh(headerComponent, headerBase,
+					std::move(vertexData), std::move(indexData),
+					materialPairings, skeletonPairings);
+}
+
+uint32_t GFGFileExporter::AddMesh(uint32_t,
+								  const std::vector<GFGVertexComponent>& headerComponent,
+								  const GFGMeshHeaderCore& headerBase,
+								  GFGSpan<const uint8_t> vertexData,
+								  GFGSpan<const uint8_t> indexData,
+								  const std::vector<GFGMeshMatPair>* materialPairings,
+								  const std::vector<GFGMeshSkelPair>* skeletonPairings)
+{
+	return PushMesh(headerComponent, headerBase,
+					vertexData, indexData,
+					materialPairings, skeletonPairings);
+}
+
+GFGAddMeshResult GFGFileExporter::ReserveMesh(const GFGTransform& transform,
+											  uint32_t parent,
+											  const std::vector<GFGVertexComponent>& headerComponent,
+											  const GFGMeshHeaderCore& headerBase,
+											  const std::vector<GFGMeshMatPair>* materialPairings,
+											  const std::vector<GFGMeshSkelPair>* skeletonPairings)
+{
+	// Data is not available to write it immediately
+	assert(streamWriter == nullptr);
+
+	uint64_t componentSizes = 0;
+	for(const GFGVertexComponent& component : headerComponent)
 	{
-		auto end = gfgHeader.meshMaterialConnections.pairs.end();
-		auto location = gfgHeader.meshMaterialConnections.pairs.insert(end,
-																	   materialPairings->begin(),
-																	   materialPairings->end());
-		// End invalid now re-end
-		end = gfgHeader.meshMaterialConnections.pairs.end();
-		for(auto i = location; i != end; i++)
-		{
-			i->meshIndex = meshID;
-		}
+		componentSizes += GFGDataTypeByteSize[static_cast<uint32_t>(component.dataType)];
 	}
+	uint64_t vertexSize = componentSizes * headerBase.vertexCount;
+	uint64_t indexSize = headerBase.indexSize * headerBase.indexCount;
 
-	// Now Can Add Actual Data
-	meshData.emplace_back(vertexData);
-	if(indexData) meshIndexData.emplace_back(*indexData);
-	else meshIndexData.emplace_back();
-
-	return meshID;
+	uint32_t meshID = PushMesh(headerComponent, headerBase,
+							   GFGExportData::Reserved(static_cast<size_t>(vertexSize)),
+							   GFGExportData::Reserved(static_cast<size_t>(indexSize)),
+							   materialPairings, skeletonPairings);
+	return PushMeshNode(transform, parent, meshID);
 }
 
 uint32_t GFGFileExporter::AddSkeleton(const std::vector<uint32_t>& parentHierarcy,
@@ -148,11 +394,11 @@ uint32_t GFGFileExporter::AddSkeleton(const std::vector<uint32_t>& parentHierarc
 	return static_cast<uint32_t>(gfgHeader.skeletons.size() - 1);
 }
 
-uint32_t GFGFileExporter::AddMaterial(GFGMaterialLogic logic,
-									  const std::vector<GFGTexturePath>* textureList,
-									  const std::vector<GFGUniformData>* uniformList,
-									  const std::vector<uint8_t>* texturePathData,
-									  const std::vector<uint8_t>* uniformData)
+uint32_t GFGFileExporter::PushMaterial(GFGMaterialLogic logic,
+									   const std::vector<GFGTexturePath>* textureList,
+									   const std::vector<GFGUniformData>* uniformList,
+									   GFGExportData&& texturePathData,
+									   GFGExportData&& uniformData)
 {
 	gfgHeader.materials.emplace_back
 	(
@@ -171,10 +417,47 @@ uint32_t GFGFileExporter::AddMaterial(GFGMaterialLogic logic,
 
 		}
 	);
-	if(textureList && texturePathData) materialTexturePath.emplace_back(*texturePathData);
-	if(uniformList && uniformData) materialUniformData.emplace_back(*uniformData);
+	uint32_t materialID = static_cast<uint32_t>(gfgHeader.materials.size() - 1);
+	if(streamWriter)
+	{
+		StreamBlock(GFGBlockType::MATERIAL_TEXTURE, materialID, texturePathData);
+		StreamBlock(GFGBlockType::MATERIAL_UNIFORM, materialID, uniformData);
+		return materialID;
+	}
+	materialTexturePath.emplace_back(std::move(texturePathData));
+	materialUniformData.emplace_back(std::move(uniformData));
+	return materialID;
+}
 
-	return static_cast<uint32_t>(gfgHeader.materials.size() - 1);
+uint32_t GFGFileExporter::AddMaterial(GFGMaterialLogic logic,
+									  const std::vector<GFGTexturePath>* textureList,
+									  const std::vector<GFGUniformData>* uniformList,
+									  const std::vector<uint8_t>* texturePathData,
+									  const std::vector<uint8_t>* uniformData)
+{
+	return PushMaterial(logic, textureList, uniformList,
+						(textureList && texturePathData) ? CopyData(*texturePathData) : GFGExportData(),
+						(uniformList && uniformData) ? CopyData(*uniformData) : GFGExportData());
+}
+
+uint32_t GFGFileExporter::AddMaterial(GFGMaterialLogic logic,
+									  const std::vector<GFGTexturePath>& textureList,
+									  const std::vector<GFGUniformData>& uniformList,
+									  std::vector<uint8_t>&& texturePathData,
+									  std::vector<uint8_t>&& uniformData)
+{
+	return PushMaterial(logic, &textureList, &uniformList,
+						std::move(texturePathData), std::move(uniformData));
+}
+
+uint32_t GFGFileExporter::AddMaterial(GFGMaterialLogic logic,
+									  const std::vector<GFGTexturePath>& textureList,
+									  const std::vector<GFGUniformData>& uniformList,
+									  GFGSpan<const uint8_t> texturePathData,
+									  GFGSpan<const uint8_t> uniformData)
+{
+	return PushMaterial(logic, &textureList, &uniformList,
+						texturePathData, uniformData);
 }
 
 uint32_t GFGFileExporter::AddNode(const GFGTransform& transform,
@@ -186,13 +469,13 @@ uint32_t GFGFileExporter::AddNode(const GFGTransform& transform,
 	return  static_cast<uint32_t>(gfgHeader.sceneHierarchy.nodes.size() - 1);
 }
 
-uint32_t  GFGFileExporter::AddAnimation(GFGAnimationLayout layout,
+uint32_t GFGFileExporter::PushAnimation(GFGAnimationLayout layout,
 										GFGAnimType type,
 										GFGQuatInterpType interpType,
 										GFGQuatLayout quatLayout,
 										uint32_t skeletonIndex,
 										uint32_t keyCount,
-										const std::vector<uint8_t>& animData)
+										GFGExportData&& animData)
 {
 	gfgHeader.animations.emplace_back
 	(
@@ -208,13 +491,69 @@ uint32_t  GFGFileExporter::AddAnimation(GFGAnimationLayout layout,
 		}
 	);
 
-	// Actual Data Push
-	animationData.emplace_back(animData);
-
 	uint32_t animID = static_cast<uint32_t>(gfgHeader.animations.size() - 1);
+
+	// Actual Data Push
+	if(streamWriter)
+		StreamBlock(GFGBlockType::ANIMATION_KEYFRAME, animID, animData);
+	else
+		animationData.emplace_back(std::move(animData));
 	return animID;
 }
 
+uint32_t GFGFileExporter::AddAnimation(GFGAnimationLayout layout,
+									   GFGAnimType type,
+									   GFGQuatInterpType interpType,
+									   GFGQuatLayout quatLayout,
+									   uint32_t skeletonIndex,
+									   uint32_t keyCount,
+									   const std::vector<uint8_t>& animData)
+{
+	return PushAnimation(layout, type, interpType, quatLayout,
+						 skeletonIndex, keyCount,
+						 CopyData(animData));
+}
+
+uint32_t GFGFileExporter::AddAnimation(GFGAnimationLayout layout,
+									   GFGAnimType type,
+									   GFGQuatInterpType interpType,
+									   GFGQuatLayout quatLayout,
+									   uint32_t skeletonIndex,
+									   uint32_t keyCount,
+									   std::vector<uint8_t>&& animData)
+{
+	return PushAnimation(layout, type, interpType, quatLayout,
+						 skeletonIndex, keyCount,
+						 std::move(animData));
+}
+
+uint32_t GFGFileExporter::AddAnimation(GFGAnimationLayout layout,
+									   GFGAnimType type,
+									   GFGQuatInterpType interpType,
+									   GFGQuatLayout quatLayout,
+									   uint32_t skeletonIndex,
+									   uint32_t keyCount,
+									   GFGSpan<const uint8_t> animData)
+{
+	return PushAnimation(layout, type, interpType, quatLayout,
+						 skeletonIndex, keyCount,
+						 animData);
+}
+
+void GFGFileExporter::EnableSpatialIndex(bool enable)
+{
+	buildSpatialIndex = enable;
+	if(!enable) gfgHeader.RemoveExtension(GFGExtensionTag::SPATIAL_INDEX);
+}
+
+void GFGFileExporter::EnableChecksums(bool enable)
+{
+	// Checksums of the existing blocks are only known if the file has them
+	assert(!(appending && enable && !buildChecksums));
+	buildChecksums = enable;
+	if(!enable) gfgHeader.RemoveExtension(GFGExtensionTag::CHECKSUMS);
+}
+
 void GFGFileExporter::Clear()
 {
 	// Header
@@ -226,10 +565,92 @@ void GFGFileExporter::Clear()
 	materialTexturePath.clear();
 	materialUniformData.clear();
 	animationData.clear();
+
+	// Stream
+	streamWriter = nullptr;
+	streamReserve = 0;
+	streamSize = 0;
+	streamedBlocks.clear();
+	dataLayout.clear();
+
+	// Copies are not referenced anymore
+	arena.release();
+
+	// Append
+	appending = false;
+	appendDataLocation = 0;
+	existingBlocks.clear();
 }
 
-void GFGFileExporter::Write(GFGFileWriterI& writer)
+GFGExportData GFGFileExporter::CopyData(const std::vector<uint8_t>& data)
 {
+	// Streamed data is written before the insertion returns, no need to copy
+	if(streamWriter || data.empty()) return GFGExportData(GFGSpan<const uint8_t>(data));
+
+	// Packed (byte aligned) so that consecutive copies are back to back
+	uint8_t* copy = static_cast<uint8_t*>(arena.allocate(data.size(), 1));
+	std::memcpy(copy, data.data(), data.size());
+	return GFGExportData(GFGSpan<const uint8_t>(copy, data.size()));
+}
+
+void GFGFileExporter::StreamBlock(GFGBlockType type, uint32_t index,
+								  const GFGExportData& data)
+{
+	// Reservation is aligned, padding the data keeps the file offsets aligned
+	uint64_t padding = AlignUp(streamSize, dataAlignment) - streamSize;
+	if(padding != 0)
+	{
+		std::vector<uint8_t> zeros(static_cast<size_t>(padding), 0);
+		streamWriter->Write(zeros.data(), zeros.size());
+		streamSize += padding;
+	}
+
+	// Checksum is always calculated since checksums can be enabled
+	// after the block is written
+	streamedBlocks.push_back(StreamedBlock
+	{
+		type,
+		index,
+		streamSize,
+		GFGCrc32C(data.data(), data.size())
+	});
+	streamWriter->Write(data.data(), data.size());
+	streamSize += data.size();
+}
+
+void GFGFileExporter::PrepareExtensions()
+{
+	if(dataAlignment > 1)
+	{
+		std::vector<uint8_t> alignmentData(sizeof(uint64_t));
+		std::memcpy(alignmentData.data(), &dataAlignment, sizeof(uint64_t));
+		gfgHeader.SetExtension(GFGExtensionTag::DATA_ALIGNMENT, std::move(alignmentData));
+	}
+	// Spatial index is built from the final hierarchy
+	if(buildSpatialIndex)
+	{
+		GFGSpatialIndex spatialIndex;
+		std::vector<uint8_t> spatialData;
+		spatialIndex.Build(gfgHeader);
+		spatialIndex.Serialize(spatialData);
+		gfgHeader.SetExtension(GFGExtensionTag::SPATIAL_INDEX, std::move(spatialData));
+	}
+	// Checksum table should be the last section, it is reserved here
+	// (size only depends on the block counts) and filled after
+	// the rest of the header is written
+	if(buildChecksums)
+	{
+		gfgHeader.RemoveExtension(GFGExtensionTag::CHECKSUMS);
+		gfgHeader.SetExtension(GFGExtensionTag::CHECKSUMS,
+							   std::vector<uint8_t>(GFGChecksumTable::SerializedSize(static_cast<uint32_t>(gfgHeader.meshes.size()),
+																					 static_cast<uint32_t>(gfgHeader.materials.size()),
+																					 static_cast<uint32_t>(gfgHeader.animations.size()))));
+	}
+}
+
+void GFGFileExporter::PrepareLayout()
+{
+	assert(streamWriter == nullptr);
 	// Before Export Calculate Header Offsets
 	assert(meshData.size() == meshIndexData.size());
 	std::vector<size_t> vertByteSize(meshData.size());
@@ -244,111 +665,549 @@ void GFGFileExporter::Write(GFGFileWriterI& writer)
 	{
 		return v.size();
 	});
+	PrepareExtensions();
 	gfgHeader.CalculateDataOffsets(vertByteSize,
-								   indexByteSize);
+								   indexByteSize,
+								   dataAlignment);
+	LayoutData();
+}
+
+void GFGFileExporter::PrepareWrite(GFGChecksumTable& checksums)
+{
+	PrepareLayout();
+	uint32_t meshCount = static_cast<uint32_t>(gfgHeader.meshes.size());
+	uint32_t materialCount = static_cast<uint32_t>(gfgHeader.materials.size());
+	uint32_t animationCount = static_cast<uint32_t>(gfgHeader.animations.size());
+
+	// Block checksums (blocks sizes are known after the offset calculation)
+	if(buildChecksums)
+	{
+		// Reserved blocks are not available to the exporter
+		assert(std::none_of(meshData.cbegin(), meshData.cend(),
+							[](const auto& v) { return v.IsReserved(); }));
+		assert(std::none_of(meshIndexData.cbegin(), meshIndexData.cend(),
+							[](const auto& v) { return v.IsReserved(); }));
+		std::vector<uint64_t> vertexSizes(meshData.size());
+		std::vector<uint64_t> indexSizes(meshIndexData.size());
+		auto dataSize = [](const auto& v) -> uint64_t { return v.size(); };
+		std::transform(meshData.cbegin(), meshData.cend(), vertexSizes.begin(), dataSize);
+		std::transform(meshIndexData.cbegin(), meshIndexData.cend(), indexSizes.begin(), dataSize);
+		std::vector<uint64_t> textureSizes(materialCount, 0);
+		std::vector<uint64_t> uniformSizes(materialCount, 0);
+		for(uint32_t i = 0; i < materialCount; i++)
+		{
+			for(const GFGTexturePath& texPath : gfgHeader.materials[i].textureList)
+				textureSizes[i] += texPath.stringSize;
+			for(const GFGUniformData& uniform : gfgHeader.materials[i].uniformList)
+				uniformSizes[i] += GFGDataTypeByteSize[static_cast<int>(uniform.dataType)];
+		}
+		std::vector<uint64_t> animationSizes(animationCount);
+		std::transform(animationData.cbegin(), animationData.cend(),
+					   animationSizes.begin(), [](const auto& v)
+		{
+			return v.size();
+		});
+
+		checksums = GFGChecksumTable(meshCount, materialCount, animationCount);
+		StreamChecksums(checksums, GFGBlockType::MESH_VERTEX, meshData, vertexSizes);
+		StreamChecksums(checksums, GFGBlockType::MESH_INDEX, meshIndexData, indexSizes);
+		StreamChecksums(checksums, GFGBlockType::MATERIAL_TEXTURE, materialTexturePath, textureSizes);
+		StreamChecksums(checksums, GFGBlockType::MATERIAL_UNIFORM, materialUniformData, uniformSizes);
+		StreamChecksums(checksums, GFGBlockType::ANIMATION_KEYFRAME, animationData, animationSizes);
+	}
+}
+
+bool GFGFileExporter::Write(GFGFileWriterI& writer)
+{
+	GFGChecksumTable checksums;
+	PrepareWrite(checksums);
 
 	// All Stuff is Ready
-	GFGHeader& header = gfgHeader;
+	// Header is serialized to a single buffer
+	GFGFileWriterMemory headerWriter;
+	headerWriter.buffer.reserve(static_cast<size_t>(gfgHeader.headerSize));
+	WriteHeader(headerWriter, gfgHeader, buildChecksums ? &checksums : nullptr);
+	assert(headerWriter.buffer.size() == gfgHeader.headerSize);
+
+	// Header and the actual data is a single gather write
+	// (reserved blocks are skipped, they split the write)
+	const std::vector<DataEntry>& entries = dataLayout;
+	std::vector<uint8_t> padding(static_cast<size_t>(dataAlignment - 1), 0);
+	std::vector<GFGWriteVec> vectors;
+	vectors.reserve(1 + entries.size() * 2);
+	vectors.push_back(GFGWriteVec{headerWriter.buffer.data(), headerWriter.buffer.size()});
+	uint64_t location = headerWriter.buffer.size();
+	for(const DataEntry& entry : entries)
+	{
+		const GFGExportData& data = *entry.data;
+		if(data.IsReserved())
+		{
+			// Writer has to seek over the reserved block
+			location = entry.location + data.size();
+			if(!writer.WriteVectored(vectors.data(), vectors.size()) ||
+			   !writer.MovePtrAbs(static_cast<size_t>(location)))
+				return false;
+			vectors.clear();
+			continue;
+		}
+		if(data.size() == 0) continue;
+		if(entry.location != location)
+			vectors.push_back(GFGWriteVec{padding.data(), static_cast<size_t>(entry.location - location)});
+		// Contiguous data (i.e. consecutive arena copies) is a single vector
+		if(!vectors.empty() && vectors.back().buffer + vectors.back().size == data.data())
+			vectors.back().size += data.size();
+		else
+			vectors.push_back(GFGWriteVec{data.data(), data.size()});
+		location = entry.location + data.size();
+	}
+	return writer.WriteVectored(vectors.data(), vectors.size());
+}
+
+bool GFGFileExporter::Write(GFGFileWriterI& writer, GFGThreadPool& threadPool,
+							uint64_t chunkSize)
+{
+	assert(chunkSize != 0);
+	if(!writer.IsWriteAtThreadSafe())
+		return Write(writer);
+
+	GFGChecksumTable checksums;
+	PrepareWrite(checksums);
+
+	// Data is laid out in the same order of the serial write
+	// each data entry is split into chunks, alignment padding is written
+	// as zero chunks (file may not be truncated)
+	std::vector<uint8_t> padding(static_cast<size_t>(dataAlignment - 1), 0);
+	std::vector<WriteChunk> chunks;
+	uint64_t location = gfgHeader.headerSize;
+	for(const DataEntry& entry : dataLayout)
+	{
+		// Reserved blocks are filled by the caller
+		const GFGExportData& data = *entry.data;
+		if(data.IsReserved())
+		{
+			location = entry.location + data.size();
+			continue;
+		}
+		if(data.size() == 0) continue;
+		if(entry.location != location)
+			chunks.push_back(WriteChunk{padding.data(), entry.location - location, location});
+		location = entry.location + data.size();
+		for(uint64_t offset = 0; offset < data.size(); offset += chunkSize)
+		{
+			uint64_t size = std::min<uint64_t>(chunkSize, data.size() - offset);
+			chunks.push_back(WriteChunk{data.data() + offset, size, entry.location + offset});
+		}
+	}
+
+	auto state = std::make_shared<WriteState>();
+	state->remainingChunks = chunks.size();
+	state->failed = false;
+	std::future<void> future = state->promise.get_future();
+	if(chunks.empty()) state->promise.set_value();
+	for(const WriteChunk& chunk : chunks)
+	{
+		threadPool.Submit([&writer, state, chunk]()
+		{
+			if(!writer.WriteAt(chunk.data, static_cast<size_t>(chunk.size),
+							   static_cast<size_t>(chunk.location)))
+				state->failed = true;
+			if(--state->remainingChunks == 0)
+				state->promise.set_value();
+		});
+	}
+
+	// Header is serialized to memory on this thread meanwhile
+	GFGFileWriterMemory headerWriter;
+	headerWriter.buffer.reserve(static_cast<size_t>(gfgHeader.headerSize));
+	WriteHeader(headerWriter, gfgHeader, buildChecksums ? &checksums : nullptr);
+	assert(headerWriter.buffer.size() == gfgHeader.headerSize);
+	bool headerWritten = writer.WriteAt(headerWriter.buffer.data(), headerWriter.buffer.size(), 0);
+
+	// Queued chunks are also run on this thread, if this is called from
+	// a pool task it may be the only worker
+	while(future.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+	{
+		if(!threadPool.RunPendingTask())
+			future.wait_for(std::chrono::microseconds(100));
+	}
+	return headerWritten && !state->failed;
+}
+
+void GFGFileExporter::SerializeHeader(std::vector<uint8_t>& data, GFGHeader& header,
+									  GFGChecksumTable* checksums)
+{
+	GFGFileWriterMemory headerWriter;
+	headerWriter.buffer.reserve(static_cast<size_t>(header.headerSize));
+	WriteHeader(headerWriter, header, checksums);
+	assert(headerWriter.buffer.size() == header.headerSize);
+	data = std::move(headerWriter.buffer);
+}
+
+void GFGFileExporter::WriteHeader(GFGFileWriterI& writer, GFGHeader& header,
+								  GFGChecksumTable* checksums)
+{
+	GFGFileWriterChecksum checksumWriter(writer);
+	GFGFileWriterI& headerWriter = checksums ? static_cast<GFGFileWriterI&>(checksumWriter) : writer;
 
 	// FourCC and Header Size
-	writer.Write(reinterpret_cast<const uint8_t*>(&header.fourCC), sizeof(uint32_t));
-	writer.Write(reinterpret_cast<const uint8_t*>(&header.headerSize), sizeof(uint64_t));
-	writer.Write(reinterpret_cast<const uint8_t*>(&header.transformJump), sizeof(uint64_t));
+	headerWriter.Write(reinterpret_cast<const uint8_t*>(&header.fourCC), sizeof(uint32_t));
+	headerWriter.Write(reinterpret_cast<const uint8_t*>(&header.headerSize), sizeof(uint64_t));
+	headerWriter.Write(reinterpret_cast<const uint8_t*>(&header.transformJump), sizeof(uint64_t));
 
 	// Mesh Jump List
 	std::vector<uint64_t>& meshJumplist = header.meshList.meshLocations;
-	writer.Write(reinterpret_cast<const uint8_t*>(&header.meshList.nodeAmount), sizeof(uint32_t));
-	writer.Write(reinterpret_cast<const uint8_t*>(meshJumplist.data()), meshJumplist.size() * sizeof(uint64_t));
+	headerWriter.Write(reinterpret_cast<const uint8_t*>(&header.meshList.nodeAmount), sizeof(uint32_t));
+	headerWriter.Write(reinterpret_cast<const uint8_t*>(meshJumplist.data()), meshJumplist.size() * sizeof(uint64_t));
 
 	// Material Jump List
 	std::vector<uint64_t>& matJumplist = header.materialList.materialLocations;
-	writer.Write(reinterpret_cast<const uint8_t*>(&header.materialList.nodeAmount), sizeof(uint32_t));
-	writer.Write(reinterpret_cast<const uint8_t*>(matJumplist.data()), matJumplist.size() * sizeof(uint64_t));
+	headerWriter.Write(reinterpret_cast<const uint8_t*>(&header.materialList.nodeAmount), sizeof(uint32_t));
+	headerWriter.Write(reinterpret_cast<const uint8_t*>(matJumplist.data()), matJumplist.size() * sizeof(uint64_t));
 
 	// Skeleton Jump List
 	std::vector<uint64_t>& skelJumplist = header.skeletonList.skeletonLocations;
-	writer.Write(reinterpret_cast<const uint8_t*>(&header.skeletonList.nodeAmount), sizeof(uint32_t));
-	writer.Write(reinterpret_cast<const uint8_t*>(skelJumplist.data()), skelJumplist.size() * sizeof(uint64_t));
+	headerWriter.Write(reinterpret_cast<const uint8_t*>(&header.skeletonList.nodeAmount), sizeof(uint32_t));
+	headerWriter.Write(reinterpret_cast<const uint8_t*>(skelJumplist.data()), skelJumplist.size() * sizeof(uint64_t));
 
 	// Animation Jump List
 	std::vector<uint64_t>& animJumplist = header.animationList.animationLocations;
-	writer.Write(reinterpret_cast<const uint8_t*>(&header.animationList.nodeAmount), sizeof(uint32_t));
-	writer.Write(reinterpret_cast<const uint8_t*>(animJumplist.data()), animJumplist.size() * sizeof(uint64_t));
+	headerWriter.Write(reinterpret_cast<const uint8_t*>(&header.animationList.nodeAmount), sizeof(uint32_t));
+	headerWriter.Write(reinterpret_cast<const uint8_t*>(animJumplist.data()), animJumplist.size() * sizeof(uint64_t));
 
 	// Hierarcy
 	const std::vector<GFGNode>& nodes = header.sceneHierarchy.nodes;
-	writer.Write(reinterpret_cast<const uint8_t*>(&header.sceneHierarchy.nodeAmount), sizeof(uint32_t));
-	writer.Write(reinterpret_cast<const uint8_t*>(nodes.data()), nodes.size() * sizeof(GFGNode));
+	headerWriter.Write(reinterpret_cast<const uint8_t*>(&header.sceneHierarchy.nodeAmount), sizeof(uint32_t));
+	headerWriter.Write(reinterpret_cast<const uint8_t*>(nodes.data()), nodes.size() * sizeof(GFGNode));
 
 	// Connections
 	// MM
 	const std::vector<GFGMeshMatPair>& mmPair = header.meshMaterialConnections.pairs;
-	writer.Write(reinterpret_cast<const uint8_t*>(&header.meshMaterialConnections.meshMatCount), sizeof(uint32_t));
-	writer.Write(reinterpret_cast<const uint8_t*>(mmPair.data()), mmPair.size() * sizeof(GFGMeshMatPair));
+	headerWriter.Write(reinterpret_cast<const uint8_t*>(&header.meshMaterialConnections.meshMatCount), sizeof(uint32_t));
+	headerWriter.Write(reinterpret_cast<const uint8_t*>(mmPair.data()), mmPair.size() * sizeof(GFGMeshMatPair));
 
 	// MS
 	const std::vector<GFGMeshSkelPair>& msPair = header.meshSkeletonConnections.connections;
-	writer.Write(reinterpret_cast<const uint8_t*>(&header.meshSkeletonConnections.meshSkelCount), sizeof(uint32_t));
-	writer.Write(reinterpret_cast<const uint8_t*>(msPair.data()), msPair.size() * sizeof(GFGMeshSkelPair));
+	headerWriter.Write(reinterpret_cast<const uint8_t*>(&header.meshSkeletonConnections.meshSkelCount), sizeof(uint32_t));
+	headerWriter.Write(reinterpret_cast<const uint8_t*>(msPair.data()), msPair.size() * sizeof(GFGMeshSkelPair));
 
 	// Sub Headers
 	// Mesh
 	for(const GFGMeshHeader& mesh : header.meshes)
 	{
-		writer.Write(reinterpret_cast<const uint8_t*>(&mesh.headerCore), sizeof(GFGMeshHeaderCore));
-		writer.Write(reinterpret_cast<const uint8_t*>(mesh.components.data()), mesh.headerCore.componentCount * sizeof(GFGVertexComponent));
+		headerWriter.Write(reinterpret_cast<const uint8_t*>(&mesh.headerCore), sizeof(GFGMeshHeaderCore));
+		headerWriter.Write(reinterpret_cast<const uint8_t*>(mesh.components.data()), mesh.headerCore.componentCount * sizeof(GFGVertexComponent));
 	}
 
 	// Material
 	for(const GFGMaterialHeader& material : header.materials)
 	{
-		writer.Write(reinterpret_cast<const uint8_t*>(&material.headerCore), sizeof(GFGMaterialHeaderCore));
-		writer.Write(reinterpret_cast<const uint8_t*>(material.textureList.data()), material.headerCore.textureCount * sizeof(GFGTexturePath));
-		writer.Write(reinterpret_cast<const uint8_t*>(material.uniformList.data()), material.headerCore.unifromCount * sizeof(GFGUniformData));
+		headerWriter.Write(reinterpret_cast<const uint8_t*>(&material.headerCore), sizeof(GFGMaterialHeaderCore));
+		headerWriter.Write(reinterpret_cast<const uint8_t*>(material.textureList.data()), material.headerCore.textureCount * sizeof(GFGTexturePath));
+		headerWriter.Write(reinterpret_cast<const uint8_t*>(material.uniformList.data()), material.headerCore.unifromCount * sizeof(GFGUniformData));
 	}
 
 	// Skeleton
 	for(const GFGSkeletonHeader& skeleton : header.skeletons)
 	{
-		writer.Write(reinterpret_cast<const uint8_t*>(&skeleton.boneAmount), sizeof(uint32_t));
-		writer.Write(reinterpret_cast<const uint8_t*>(skeleton.bones.data()), skeleton.boneAmount * sizeof(GFGBone));
+		headerWriter.Write(reinterpret_cast<const uint8_t*>(&skeleton.boneAmount), sizeof(uint32_t));
+		headerWriter.Write(reinterpret_cast<const uint8_t*>(skeleton.bones.data()), skeleton.boneAmount * sizeof(GFGBone));
 	}
 
 	// Animation
 	for(const GFGAnimationHeader& anim : header.animations)
 	{
-		writer.Write(reinterpret_cast<const uint8_t*>(&anim), sizeof(GFGAnimationHeader));
+		headerWriter.Write(reinterpret_cast<const uint8_t*>(&anim), sizeof(GFGAnimationHeader));
 	}
 
 	// Transforms
 	// Node
 	const std::vector<GFGTransform>& transforms = header.transformData.transforms;
-	writer.Write(reinterpret_cast<const uint8_t*>(&header.transformData.transformAmount), sizeof(uint32_t));
-	writer.Write(reinterpret_cast<const uint8_t*>(transforms.data()), transforms.size() * sizeof(GFGTransform));
+	headerWriter.Write(reinterpret_cast<const uint8_t*>(&header.transformData.transformAmount), sizeof(uint32_t));
+	headerWriter.Write(reinterpret_cast<const uint8_t*>(transforms.data()), transforms.size() * sizeof(GFGTransform));
 
 	// Connections
 	// Bone
 	const std::vector<GFGTransform>& bTransforms = header.bonetransformData.transforms;
-	writer.Write(reinterpret_cast<const uint8_t*>(&header.bonetransformData.transformAmount), sizeof(uint32_t));
-	writer.Write(reinterpret_cast<const uint8_t*>(bTransforms.data()), bTransforms.size() * sizeof(GFGTransform));
+	headerWriter.Write(reinterpret_cast<const uint8_t*>(&header.bonetransformData.transformAmount), sizeof(uint32_t));
+	headerWriter.Write(reinterpret_cast<const uint8_t*>(bTransforms.data()), bTransforms.size() * sizeof(GFGTransform));
 
-	// Actual Data
-	// Mesh
-	for(const std::vector<uint8_t>& meshVertexData : meshData)
-		writer.Write(meshVertexData.data(), meshVertexData.size());
-	for(const std::vector<uint8_t>& meshIndexData : meshIndexData)
-		writer.Write(meshIndexData.data(), meshIndexData.size());
+	// Extensions
+	for(GFGHeaderExtension& extension : header.extensions)
+	{
+		uint64_t extensionSize = extension.data.size();
+		headerWriter.Write(reinterpret_cast<const uint8_t*>(&extension.tag), sizeof(uint32_t));
+		headerWriter.Write(reinterpret_cast<const uint8_t*>(&extensionSize), sizeof(uint64_t));
+		if(checksums && extension.tag == GFGExtensionTag::CHECKSUMS)
+		{
+			// Header checksum covers everything before the table
+			checksums->SetHeaderChecksum(checksumWriter.Checksum());
+			checksums->Serialize(extension.data);
+			assert(extension.data.size() == extensionSize);
+		}
+		headerWriter.Write(extension.data.data(), extension.data.size());
+	}
+}
 
-	// Material
-	for(const std::vector<uint8_t>& materialTexturePath : materialTexturePath)
-		writer.Write(materialTexturePath.data(), materialTexturePath.size());
-	for(const std::vector<uint8_t>& materialUniformData : materialUniformData)
-		writer.Write(materialUniformData.data(), materialUniformData.size());
+void GFGFileExporter::StartStream(GFGFileWriterI& writer, uint64_t headerReserve)
+{
+	Clear();
+	streamWriter = &writer;
+	streamReserve = AlignUp(headerReserve, dataAlignment);
+	headerReserve = streamReserve;
 
-	// Animation
-	for(const std::vector<uint8_t>& animationData : animationData)
-		writer.Write(animationData.data(), animationData.size());
+	// Reservation is zero filled, header is written over it on finish
+	std::vector<uint8_t> zeros(static_cast<size_t>(std::min<uint64_t>(headerReserve, ZeroFillSize)));
+	for(uint64_t offset = 0; offset < headerReserve; offset += zeros.size())
+	{
+		size_t size = static_cast<size_t>(std::min<uint64_t>(zeros.size(), headerReserve - offset));
+		writer.Write(zeros.data(), size);
+	}
+}
+
+bool GFGFileExporter::FinishStream()
+{
+	assert(streamWriter != nullptr);
+	GFGFileWriterI& writer = *streamWriter;
+
+	PrepareExtensions();
+	gfgHeader.CalculateHeaderOffsets();
+	// Appended header goes after the new blocks, writer is already there
+	if(!appending &&
+	   (gfgHeader.headerSize > streamReserve || !writer.MovePtrAbs(0)))
+	{
+		Clear();
+		return false;
+	}
+
+	// Data offsets are relative to the end of the header (unused part of
+	// the reservation is skipped) or to the data start of the appended file
+	uint64_t dataLocation = appending ? appendDataLocation : gfgHeader.headerSize;
+	uint64_t shift = streamReserve - dataLocation;
+	GFGChecksumTable checksums;
+	if(buildChecksums)
+	{
+		checksums = GFGChecksumTable(static_cast<uint32_t>(gfgHeader.meshes.size()),
+									 static_cast<uint32_t>(gfgHeader.materials.size()),
+									 static_cast<uint32_t>(gfgHeader.animations.size()));
+		for(const StreamedBlock& block : existingBlocks)
+			checksums.SetBlockChecksum(block.type, block.index, block.checksum);
+	}
+	for(const StreamedBlock& block : streamedBlocks)
+	{
+		uint64_t start = shift + block.start;
+		switch(block.type)
+		{
+			case GFGBlockType::MESH_VERTEX:
+				gfgHeader.meshes[block.index].headerCore.vertexStart = start;
+				break;
+			case GFGBlockType::MESH_INDEX:
+				gfgHeader.meshes[block.index].headerCore.indexStart = start;
+				break;
+			case GFGBlockType::MATERIAL_TEXTURE:
+			{
+				GFGMaterialHeader& material = gfgHeader.materials[block.index];
+				material.headerCore.textureStart = start;
+				uint64_t location = 0;
+				for(GFGTexturePath& texPath : material.textureList)
+				{
+					texPath.stringLocation = location;
+					location += texPath.stringSize;
+				}
+				break;
+			}
+			case GFGBlockType::MATERIAL_UNIFORM:
+			{
+				GFGMaterialHeader& material = gfgHeader.materials[block.index];
+				material.headerCore.uniformStart = start;
+				uint64_t location = 0;
+				for(GFGUniformData& uniform : material.uniformList)
+				{
+					uniform.dataLocation = location;
+					location += GFGDataTypeByteSize[static_cast<int>(uniform.dataType)];
+				}
+				break;
+			}
+			case GFGBlockType::ANIMATION_KEYFRAME:
+				gfgHeader.animations[block.index].dataStart = start;
+				break;
+		}
+		if(buildChecksums) checksums.SetBlockChecksum(block.type, block.index, block.checksum);
+	}
+	WriteHeader(writer, gfgHeader, buildChecksums ? &checksums : nullptr);
+	if(appending)
+	{
+		// Trailer points to the new header, file is switched
+		// to the new header with this (last) write
+		GFGHeaderTrailer trailer =
+		{
+			streamReserve + streamSize,
+			appendDataLocation,
+			GFGTrailerFourCC
+		};
+		writer.Write(reinterpret_cast<const uint8_t*>(&trailer), sizeof(GFGHeaderTrailer));
+		Clear();
+		return true;
+	}
+
+	// Leave the writer at the end of the file
+	bool result = writer.MovePtrAbs(static_cast<size_t>(streamReserve + streamSize));
+	Clear();
+	return result;
+}
+
+bool GFGFileExporter::IsStreaming() const
+{
+	return streamWriter != nullptr;
+}
+
+bool GFGFileExporter::StartAppend(GFGFileWriterI& writer, const GFGFileLoader& loader)
+{
+	Clear();
+	uint64_t fileSize = loader.FileSize();
+	if(!writer.MovePtrAbs(static_cast<size_t>(fileSize))) return false;
+
+	// Continue from the header of the file
+	if(loader.MaterializeHeader() != GFGFileError::OK) return false;
+	gfgHeader = loader.Header();
+	dataAlignment = loader.DataAlignment();
+	buildSpatialIndex = gfgHeader.FindExtension(GFGExtensionTag::SPATIAL_INDEX) != nullptr;
+	buildChecksums = gfgHeader.FindExtension(GFGExtensionTag::CHECKSUMS) != nullptr;
+	if(buildChecksums)
+	{
+		// Existing blocks are not read again, their stored checksums are kept
+		// (table of the file should be readable)
+		auto StoreChecksums = [&](GFGBlockType type, size_t count)
+		{
+			for(uint32_t i = 0; i < static_cast<uint32_t>(count); i++)
+			{
+				uint32_t checksum;
+				if(loader.BlockChecksum(checksum, type, i) != GFGFileError::OK)
+					return false;
+				existingBlocks.push_back(StreamedBlock{type, i, 0, checksum});
+			}
+			return true;
+		};
+		if(!StoreChecksums(GFGBlockType::MESH_VERTEX, gfgHeader.meshes.size()) ||
+		   !StoreChecksums(GFGBlockType::MESH_INDEX, gfgHeader.meshes.size()) ||
+		   !StoreChecksums(GFGBlockType::MATERIAL_TEXTURE, gfgHeader.materials.size()) ||
+		   !StoreChecksums(GFGBlockType::MATERIAL_UNIFORM, gfgHeader.materials.size()) ||
+		   !StoreChecksums(GFGBlockType::ANIMATION_KEYFRAME, gfgHeader.animations.size()))
+		{
+			Clear();
+			return false;
+		}
+	}
+
+	// New blocks start at the aligned end of the file
+	streamWriter = &writer;
+	streamReserve = AlignUp(fileSize, dataAlignment);
+	appending = true;
+	appendDataLocation = loader.DataLocation();
+	std::vector<uint8_t> zeros(static_cast<size_t>(streamReserve - fileSize), 0);
+	if(!zeros.empty()) writer.Write(zeros.data(), zeros.size());
+	return true;
+}
+
+bool GFGFileExporter::IsAppending() const
+{
+	return appending;
+}
+
+uint64_t GFGFileExporter::CalculateFileSize()
+{
+	PrepareLayout();
+
+	uint64_t fileSize = gfgHeader.headerSize;
+	for(const DataEntry& entry : dataLayout)
+		fileSize = std::max<uint64_t>(fileSize, entry.location + entry.data->size());
+	return fileSize;
+}
+
+void GFGFileExporter::SetDataAlignment(uint64_t alignment)
+{
+	assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+	dataAlignment = alignment;
+	if(alignment == 1) gfgHeader.RemoveExtension(GFGExtensionTag::DATA_ALIGNMENT);
+}
+
+void GFGFileExporter::LayoutData()
+{
+	// Same layout of the GFGHeader::CalculateDataOffsets
+	// (assuming data entries are one to one with the blocks)
+	// except duplicates, they point to the first copy
+	dataLayout.clear();
+	uint64_t location = gfgHeader.headerSize;
+	const std::pair<GFGBlockType, const std::vector<GFGExportData>*> dataLists[] =
+	{
+		{GFGBlockType::MESH_VERTEX, &meshData},
+		{GFGBlockType::MESH_INDEX, &meshIndexData},
+		{GFGBlockType::MATERIAL_TEXTURE, &materialTexturePath},
+		{GFGBlockType::MATERIAL_UNIFORM, &materialUniformData},
+		{GFGBlockType::ANIMATION_KEYFRAME, &animationData}
+	};
+	for(const auto& dataList : dataLists)
+	{
+		// Size and hash of the unique blocks of this type, to the layout index
+		std::multimap<std::pair<uint64_t, uint32_t>, size_t> uniqueBlocks;
+		const std::vector<GFGExportData>& blocks = *dataList.second;
+		for(uint32_t i = 0; i < static_cast<uint32_t>(blocks.size()); i++)
+		{
+			const GFGExportData& data = blocks[i];
+			// Uniform blocks are not shared, they are edited in place (GFGFilePatcher)
+			bool checkDuplicate = deduplicateBlocks && !data.IsReserved() && data.size() != 0 &&
+								  dataList.first != GFGBlockType::MATERIAL_UNIFORM;
+			std::pair<uint64_t, uint32_t> key;
+			if(checkDuplicate)
+			{
+				key = std::make_pair(static_cast<uint64_t>(data.size()),
+									 GFGCrc32C(data.data(), data.size()));
+				auto range = uniqueBlocks.equal_range(key);
+				auto match = std::find_if(range.first, range.second, [&](const auto& unique)
+				{
+					const GFGExportData& uniqueData = *dataLayout[unique.second].data;
+					return std::memcmp(uniqueData.data(), data.data(), data.size()) == 0;
+				});
+				if(match != range.second)
+				{
+					SetBlockStart(dataList.first, i, dataLayout[match->second].location - gfgHeader.headerSize);
+					continue;
+				}
+			}
+
+			location = AlignUp(location, dataAlignment);
+			if(checkDuplicate) uniqueBlocks.emplace(key, dataLayout.size());
+			dataLayout.push_back(DataEntry{&data, location});
+			if(deduplicateBlocks) SetBlockStart(dataList.first, i, location - gfgHeader.headerSize);
+			location += data.size();
+		}
+	}
+}
 
+void GFGFileExporter::SetBlockStart(GFGBlockType type, uint32_t index, uint64_t start)
+{
+	switch(type)
+	{
+		case GFGBlockType::MESH_VERTEX:
+			gfgHeader.meshes[index].headerCore.vertexStart = start;
+			break;
+		case GFGBlockType::MESH_INDEX:
+			gfgHeader.meshes[index].headerCore.indexStart = start;
+			break;
+		case GFGBlockType::MATERIAL_TEXTURE:
+			gfgHeader.materials[index].headerCore.textureStart = start;
+			break;
+		case GFGBlockType::MATERIAL_UNIFORM:
+			gfgHeader.materials[index].headerCore.uniformStart = start;
+			break;
+		case GFGBlockType::ANIMATION_KEYFRAME:
+			gfgHeader.animations[index].dataStart = start;
+			break;
+	}
+}
+
+void GFGFileExporter::EnableDeduplication(bool enable)
+{
+	deduplicateBlocks = enable;
 }
 
 const GFGHeader& GFGFileExporter::Header()
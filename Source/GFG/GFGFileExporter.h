@@ -3,6 +3,7 @@
 GFGFileWriteI Interface
 GFGFileWriterSTL Class
 GFGAddMeshResult Struct
+GFGExportData Class
 GFGFileExporter Class
 
 File IO seperated with interface so you can use your faviourite
@@ -10,6 +11,51 @@ File API or you can use already implemented STL.
 
 GFGFileExporter used to create new GFG Files.
 
+Data given to the exporter is copied by default. Copies are allocated from a
+chunked arena (std::pmr::monotonic_buffer_resource, its upstream resource can be
+given on construction) so that blocks are contiguous in large chunks, adjacent
+blocks are merged to a single write and Clear releases all of the copies at once.
+Data can also be moved in (std::vector<uint8_t>&& overloads) or borrowed
+(GFGSpan overloads) so that large scenes are not duplicated in memory. Borrowed
+data is not copied, caller should keep it alive (and unchanged) until Write.
+
+In streaming mode (StartStream) data blocks are written to the file as they
+are added and only the header is kept in memory. Space for the header is
+reserved at the start of the file and the header is written there on
+FinishStream, so the writer should be able to seek. Unused part of the
+reservation lies between the header and the first data block (data offsets
+account for it). Blocks are laid out in the order they are added, not
+grouped by type.
+
+Append mode (StartAppend) is streaming on an existing file. Header of the file is
+loaded to the exporter, new data blocks are written at the end of the file and the
+new header is written after them, followed by a GFGHeaderTrailer that points to it.
+Existing data blocks are not moved (their offsets stay valid) so the cost of an
+append depends only on the appended data. Header at the start of the file is not
+touched, readers that do not know the trailer see the file before the appends.
+
+Header is serialized to a single buffer before it is written, then header and
+data blocks are given to the writer as a single gather write
+(GFGFileWriterI::WriteVectored) so that writers can issue few large writes.
+
+Data blocks of a mesh can also be reserved (ReserveMesh), exporter does not
+hold or write the data of reserved blocks. After CalculateFileSize, block
+locations are final (Header().headerSize + block start) and the caller fills
+the blocks directly on the output (i.e. mapping of the GFGFileWriterMMap)
+before or after Write. Checksums can not be built when blocks are reserved.
+Writer should be able to seek over the reserved blocks, Write fails otherwise.
+
+Deduplication (EnableDeduplication) hashes the data blocks on Write, byte-identical
+blocks of the same type are written once and share the same offset. Material
+uniform blocks are never shared since GFGFilePatcher edits them in place.
+
+Write can also be given a GFGThreadPool. Since every block offset is known
+after the offset calculation, header and data blocks (large blocks are split
+into chunks) are written concurrently with positional writes. Output is
+identical to the serial Write (padding is written as zeros, so the
+writer does not need to truncate the file). Writer should support thread safe positional
+writes (GFGFileWriterI::IsWriteAtThreadSafe), if not file is written serially.
+
 For License refer to:
 https://github.com/yalcinerbora/GFGFileFormat/blob/master/LICENSE
 */
@@ -19,9 +65,22 @@ https://github.com/yalcinerbora/GFGFileFormat/blob/master/LICENSE
 
 #include <vector>
 #include <fstream>
+#include <memory_resource>
 
 #include "GFGEnumerations.h"
 #include "GFGHeader.h"
+#include "GFGSpan.h"
+
+class GFGChecksumTable;
+class GFGThreadPool;
+class GFGFileLoader;
+
+// Gather write, writes the buffers in order as a contiguous range
+struct GFGWriteVec
+{
+	const uint8_t*	buffer;
+	size_t			size;
+};
 
 // Seperation of File Reading and Layingout the file
 class GFGFileWriterI
@@ -30,6 +89,21 @@ class GFGFileWriterI
 	protected:
 	public:
 		virtual void	Write(const uint8_t buffer[], size_t readAmount) = 0;
+		// Moves the write position, writers that can not seek return false
+		virtual bool	MovePtrAbs(size_t) { return false; }
+
+		// Positional write, writes to the absolute location
+		// Default implementation moves the write position then writes
+		// thus it is not thread safe
+		// Returns false if the data could not be written
+		virtual bool	WriteAt(const uint8_t buffer[], size_t writeAmount, size_t absLocation);
+		// Implementations should return true if WriteAt can be called
+		// concurrently from multiple threads
+		virtual bool	IsWriteAtThreadSafe() const { return false; }
+		// Writes multiple buffers from the current write position
+		// Default implementation calls Write for each buffer
+		// Returns false if the data could not be written
+		virtual bool	WriteVectored(const GFGWriteVec vectors[], size_t vectorCount);
 };
 
 class GFGFileWriterSTL : public GFGFileWriterI
@@ -43,6 +117,7 @@ class GFGFileWriterSTL : public GFGFileWriterI
 				GFGFileWriterSTL(std::ofstream& fileReader);
 
 		void	Write(const uint8_t buffer[], size_t readAmount) override;
+		bool	MovePtrAbs(size_t absLocation) override;
 };
 
 struct GFGAddMeshResult
@@ -51,6 +126,35 @@ struct GFGAddMeshResult
 	uint32_t nodeIndex;
 };
 
+// Data block of the exporter, either owned (copied or moved in), borrowed
+// or reserved (only the size is known, data is written by the user)
+class GFGExportData
+{
+	private:
+		std::vector<uint8_t>	owned;
+		GFGSpan<const uint8_t>	view;
+
+	protected:
+	public:
+		// Constructors & Destructor
+								GFGExportData() = default;
+								GFGExportData(std::vector<uint8_t>&& data);
+								GFGExportData(GFGSpan<const uint8_t> borrowed);
+								GFGExportData(const GFGExportData&);
+								GFGExportData(GFGExportData&&) noexcept = default;
+		GFGExportData&			operator=(const GFGExportData&);
+		GFGExportData&			operator=(GFGExportData&&) noexcept = default;
+								~GFGExportData() = default;
+
+		static GFGExportData	Reserved(size_t size);
+
+		// Access
+		const uint8_t*			data() const;		// nullptr if reserved
+		size_t					size() const;
+		bool					IsBorrowed() const;
+		bool					IsReserved() const;
+};
+
 class GFGFileExporter
 {
 	private:
@@ -60,20 +164,100 @@ class GFGFileExporter
 
 		// Datas
 		// Mesh Data
-		std::vector<std::vector<uint8_t>>	meshData;
-		std::vector<std::vector<uint8_t>>	meshIndexData;
+		std::vector<GFGExportData>			meshData;
+		std::vector<GFGExportData>			meshIndexData;
 
 		// Material Uniforms, Texture FilePaths
-		std::vector<std::vector<uint8_t>>	materialUniformData;
-		std::vector<std::vector<uint8_t>>	materialTexturePath;
+		std::vector<GFGExportData>			materialUniformData;
+		std::vector<GFGExportData>			materialTexturePath;
 
 		// Animation Data
-		std::vector<std::vector<uint8_t>>	animationData;
+		std::vector<GFGExportData>			animationData;
+
+		// Options
+		bool								buildSpatialIndex = false;
+		bool								buildChecksums = false;
+		bool								deduplicateBlocks = false;
+		uint64_t							dataAlignment = 1;
+
+		// Data entry in file order and its absolute file location
+		// (duplicate blocks are not in the layout)
+		struct DataEntry
+		{
+			const GFGExportData*	data;
+			uint64_t				location;
+		};
+		std::vector<DataEntry>				dataLayout;
+		// Generates the data layout and sets the block starts of the header from it
+		void								LayoutData();
+		void								SetBlockStart(GFGBlockType, uint32_t index, uint64_t start);
+
+		// Streaming
+		struct StreamedBlock
+		{
+			GFGBlockType	type;
+			uint32_t		index;
+			uint64_t		start;			// Relative to the end of the reservation
+			uint32_t		checksum;
+		};
+		GFGFileWriterI*						streamWriter = nullptr;
+		uint64_t							streamReserve = 0;
+		uint64_t							streamSize = 0;
+		std::vector<StreamedBlock>			streamedBlocks;			// In file order
+
+		// Append
+		bool								appending = false;
+		uint64_t							appendDataLocation = 0;	// Data start of the appended file
+		std::vector<StreamedBlock>			existingBlocks;			// Checksums of the blocks already in the file
+
+		// Copied data (released on Clear)
+		std::pmr::monotonic_buffer_resource	arena;
+
+		GFGExportData						CopyData(const std::vector<uint8_t>& data);
+		void								StreamBlock(GFGBlockType type, uint32_t index,
+														const GFGExportData& data);
+
+		// Header extensions that are generated on write
+		void								PrepareExtensions();
+		// Extensions and data offsets of Write
+		void								PrepareLayout();
+		// Layout and block checksums of Write
+		void								PrepareWrite(GFGChecksumTable& checksums);
+		static void							WriteHeader(GFGFileWriterI&, GFGHeader&, GFGChecksumTable* checksums);
+
+		// Common part of the insertion overloads
+		uint32_t							PushMesh(const std::vector<GFGVertexComponent>& headerComponent,
+													 const GFGMeshHeaderCore& headerBase,
+													 GFGExportData&& vertexData,
+													 GFGExportData&& indexData,
+													 const std::vector<GFGMeshMatPair>* materialPairings,
+													 const std::vector<GFGMeshSkelPair>* skeletonPairings);
+		GFGAddMeshResult					PushMeshNode(const GFGTransform& transform,
+														 uint32_t parent,
+														 uint32_t meshIndex);
+		uint32_t							PushMaterial(GFGMaterialLogic logic,
+														 const std::vector<GFGTexturePath>* textureList,
+														 const std::vector<GFGUniformData>* uniformList,
+														 GFGExportData&& texturePathData,
+														 GFGExportData&& uniformData);
+		uint32_t							PushAnimation(GFGAnimationLayout layout,
+														  GFGAnimType type,
+														  GFGQuatInterpType interpType,
+														  GFGQuatLayout quatLayout,
+														  uint32_t skeletonIndex,
+														  uint32_t keyCount,
+														  GFGExportData&& animationData);
 
 	protected:
 	public:
 		// Constructors & Destructor
-							GFGFileExporter() = default;
+		static constexpr size_t	DefaultArenaChunkSize = 4 * 1024 * 1024;
+
+							GFGFileExporter();
+		explicit			GFGFileExporter(std::pmr::memory_resource* upstream,
+											size_t arenaChunkSize = DefaultArenaChunkSize);
+							GFGFileExporter(const GFGFileExporter&) = delete;
+		GFGFileExporter&	operator=(const GFGFileExporter&) = delete;
 							~GFGFileExporter() = default;
 
 		// Insertion
@@ -85,6 +269,22 @@ class GFGFileExporter
 									const std::vector<uint8_t>* indexData = nullptr,
 									const std::vector<GFGMeshMatPair>* materialPairings = nullptr,
 									const std::vector<GFGMeshSkelPair>* skeletonPairings = nullptr);
+		GFGAddMeshResult	AddMesh(const GFGTransform& transform,
+									uint32_t parent,
+									const std::vector<GFGVertexComponent>& headerComponent,
+									const GFGMeshHeaderCore& headerBase,
+									std::vector<uint8_t>&& vertexData,
+									std::vector<uint8_t>&& indexData = std::vector<uint8_t>(),
+									const std::vector<GFGMeshMatPair>* materialPairings = nullptr,
+									const std::vector<GFGMeshSkelPair>* skeletonPairings = nullptr);
+		GFGAddMeshResult	AddMesh(const GFGTransform& transform,
+									uint32_t parent,
+									const std::vector<GFGVertexComponent>& headerComponent,
+									const GFGMeshHeaderCore& headerBase,
+									GFGSpan<const uint8_t> vertexData,
+									GFGSpan<const uint8_t> indexData = GFGSpan<const uint8_t>(),
+									const std::vector<GFGMeshMatPair>* materialPairings = nullptr,
+									const std::vector<GFGMeshSkelPair>* skeletonPairings = nullptr);
 		uint32_t			AddMesh(uint32_t parent,
 									const std::vector<GFGVertexComponent>& headerComponent,
 									const GFGMeshHeaderCore& headerBase,
@@ -92,6 +292,27 @@ class GFGFileExporter
 									const std::vector<uint8_t>* indexData = nullptr,
 									const std::vector<GFGMeshMatPair>* materialPairings = nullptr,
 									const std::vector<GFGMeshSkelPair>* skeletonPairings = nullptr);
+		uint32_t			AddMesh(uint32_t parent,
+									const std::vector<GFGVertexComponent>& headerComponent,
+									const GFGMeshHeaderCore& headerBase,
+									std::vector<uint8_t>&& vertexData,
+									std::vector<uint8_t>&& indexData = std::vector<uint8_t>(),
+									const std::vector<GFGMeshMatPair>* materialPairings = nullptr,
+									const std::vector<GFGMeshSkelPair>* skeletonPairings = nullptr);
+		uint32_t			AddMesh(uint32_t parent,
+									const std::vector<GFGVertexComponent>& headerComponent,
+									const GFGMeshHeaderCore& headerBase,
+									GFGSpan<const uint8_t> vertexData,
+									GFGSpan<const uint8_t> indexData = GFGSpan<const uint8_t>(),
+									const std::vector<GFGMeshMatPair>* materialPairings = nullptr,
+									const std::vector<GFGMeshSkelPair>* skeletonPairings = nullptr);
+		// Data sizes are calculated from the vertex/index counts and the components
+		GFGAddMeshResult	ReserveMesh(const GFGTransform& transform,
+										uint32_t parent,
+										const std::vector<GFGVertexComponent>& headerComponent,
+										const GFGMeshHeaderCore& headerBase,
+										const std::vector<GFGMeshMatPair>* materialPairings = nullptr,
+										const std::vector<GFGMeshSkelPair>* skeletonPairings = nullptr);
 		uint32_t			AddSkeleton(const std::vector<uint32_t>& parentHierarcy,
 										const std::vector<GFGTransform>& transforms);
 		uint32_t			AddMaterial(GFGMaterialLogic logic,
@@ -99,6 +320,16 @@ class GFGFileExporter
 										const std::vector<GFGUniformData>* uniformList = nullptr,
 										const std::vector<uint8_t>* texturePathData = nullptr,
 										const std::vector<uint8_t>* uniformData = nullptr);
+		uint32_t			AddMaterial(GFGMaterialLogic logic,
+										const std::vector<GFGTexturePath>& textureList,
+										const std::vector<GFGUniformData>& uniformList,
+										std::vector<uint8_t>&& texturePathData,
+										std::vector<uint8_t>&& uniformData);
+		uint32_t			AddMaterial(GFGMaterialLogic logic,
+										const std::vector<GFGTexturePath>& textureList,
+										const std::vector<GFGUniformData>& uniformList,
+										GFGSpan<const uint8_t> texturePathData,
+										GFGSpan<const uint8_t> uniformData);
 		uint32_t			AddNode(const GFGTransform& transform,
 									uint32_t parent);
 		uint32_t			AddAnimation(GFGAnimationLayout layout,
@@ -108,13 +339,85 @@ class GFGFileExporter
 										 uint32_t skeletonIndex,
 										 uint32_t keyCount,
 										 const std::vector<uint8_t>& animationData);
+		uint32_t			AddAnimation(GFGAnimationLayout layout,
+										 GFGAnimType type,
+										 GFGQuatInterpType interpType,
+										 GFGQuatLayout quatLayout,
+										 uint32_t skeletonIndex,
+										 uint32_t keyCount,
+										 std::vector<uint8_t>&& animationData);
+		uint32_t			AddAnimation(GFGAnimationLayout layout,
+										 GFGAnimType type,
+										 GFGQuatInterpType interpType,
+										 GFGQuatLayout quatLayout,
+										 uint32_t skeletonIndex,
+										 uint32_t keyCount,
+										 GFGSpan<const uint8_t> animationData);
+
+		// Options
+		// Spatial index (BVH over world space bounds of the mesh nodes)
+		// is built on Write and stored as a header extension
+		void				EnableSpatialIndex(bool);
+		// CRC32C of the header and each data block is stored
+		// as a header extension (refer to GFGChecksumTable)
+		void				EnableChecksums(bool);
+		// File offset of each data block will be a multiple of the alignment
+		// (power of two, 1 means packed), alignment is stored as a header extension
+		// Streaming mode also aligns its reservation and blocks (set before StartStream)
+		void				SetDataAlignment(uint64_t);
+		// Byte-identical data blocks of the same type are written once on Write,
+		// their headers point to the same data (GFGFileLoader::SharedBlocks)
+		// Material uniform blocks are excluded, streaming mode does not deduplicate
+		void				EnableDeduplication(bool);
+
+		static constexpr uint64_t	DefaultChunkSize = 4 * 1024 * 1024;
 
-		void				Write(GFGFileWriterI&);
+		// Returns false if a write fails or the writer can not seek over a reserved block
+		bool				Write(GFGFileWriterI&);
+		// Writes the header and the data blocks concurrently,
+		// returns when the whole file is written (calling thread runs
+		// queued tasks of the pool while waiting, can be called from a pool task)
+		// Returns false if any of the positional writes fails
+		bool				Write(GFGFileWriterI&, GFGThreadPool&,
+								  uint64_t chunkSize = DefaultChunkSize);
 		void				Clear();
+		// Calculates the file layout and returns the size of the file that Write
+		// will produce (data offsets of the header are valid afterwards)
+		uint64_t			CalculateFileSize();
+
+		// Streaming
+		static constexpr uint64_t	DefaultHeaderReserve = 1024 * 1024;
+
+		// Clears the exporter and reserves "headerReserve" bytes for the header,
+		// data given to the insertion functions is written immediately afterwards
+		// (borrowed data does not need to outlive the call)
+		void				StartStream(GFGFileWriterI&, uint64_t headerReserve = DefaultHeaderReserve);
+		// Writes the header to the reservation, returns false if the header does not
+		// fit or the writer can not seek (file is not valid in that case)
+		// Exporter is cleared afterwards
+		bool				FinishStream();
+		bool				IsStreaming() const;
+
+		// Append
+		// Loads the header of the file (loader should be opened on the same file) and
+		// starts streaming at the end of the file, writer should open the file without
+		// truncating it. Data alignment, spatial index and checksum options are taken
+		// from the file (checksums can only be kept if the file already has them).
+		// FinishStream writes the new header and the trailer.
+		// Returns false if the writer can not seek, header of the file can not be
+		// materialized or a block checksum of the file can not be read
+		bool				StartAppend(GFGFileWriterI&, const GFGFileLoader&);
+		bool				IsAppending() const;
 
 		// Access
 		const GFGHeader&	Header();
 
+		// Serializes a header which has its offsets calculated, if "checksums" is
+		// given the header checksum is calculated and the CHECKSUMS section is filled
+		// from it (i.e. GFGFilePatcher rewrites headers of existing files with this)
+		static void			SerializeHeader(std::vector<uint8_t>& data, GFGHeader&,
+											GFGChecksumTable* checksums);
+
 };		
 
-#endif //__GFG_FILEEXPORTER_H__
\ No newline at end of file
+#endif //__GFG_FILEEXPORTER_H__
\ No newline at end of file
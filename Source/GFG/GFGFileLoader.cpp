@@ -1,7 +1,12 @@
 #include "GFGFileLoader.h"
+#include "GFGStridedCopy.h"
+#include "GFGConversion.h"
+#include "GFGSpatialIndex.h"
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <limits>
+#include <map>
 
 size_t GFGFileLoader::EmptyHeaderSize =
 	sizeof(uint32_t) +			// FourCC Size
@@ -21,6 +26,83 @@ size_t GFGFileLoader::EmptyHeaderSize =
 	sizeof(uint32_t);			// Skeleton Transform Data Size
 
 
+// Lazy sub-header decode states
+namespace
+{
+	enum DecodeState : uint8_t
+	{
+		NOT_DECODED = 0,
+		DECODED,
+		CORRUPTED
+	};
+}
+
+// Vertex component groups (components that share a start offset)
+namespace
+{
+	struct VertexGroup
+	{
+		uint64_t	startOffset;
+		uint64_t	stride;
+		uint64_t	elementEnd;		// Furthest used byte in a single element
+	};
+
+	std::vector<VertexGroup> VertexGroups(const std::vector<GFGVertexComponent>& components)
+	{
+		std::vector<VertexGroup> groups;
+		for(const GFGVertexComponent& c : components)
+		{
+			uint64_t end = c.internalOffset + GFGDataTypeByteSize[static_cast<uint32_t>(c.dataType)];
+			auto it = std::find_if(groups.begin(), groups.end(), [&](const VertexGroup& g)
+			{
+				return g.startOffset == c.startOffset;
+			});
+			if(it == groups.end())
+				groups.push_back(VertexGroup{c.startOffset, GFGComponentStride(c), end});
+			else
+				it->elementEnd = std::max(it->elementEnd, end);
+		}
+		std::sort(groups.begin(), groups.end(), [](const VertexGroup& a, const VertexGroup& b)
+		{
+			return a.startOffset < b.startOffset;
+		});
+		return groups;
+	}
+
+	// Size of "count" elements of the group when packed back to back
+	uint64_t GroupRangeSize(const VertexGroup& g, uint64_t count)
+	{
+		return count * std::max(g.stride, g.elementEnd);
+	}
+
+	template <class T>
+	bool RebaseIndices(uint8_t data[], uint64_t indexCount, uint64_t vertexCount,
+					   uint64_t& firstVertex, uint64_t& rangeCount)
+	{
+		T minIndex = std::numeric_limits<T>::max();
+		T maxIndex = 0;
+		for(uint64_t i = 0; i < indexCount; i++)
+		{
+			T index;
+			std::memcpy(&index, data + i * sizeof(T), sizeof(T));
+			minIndex = std::min(minIndex, index);
+			maxIndex = std::max(maxIndex, index);
+		}
+		if(maxIndex >= vertexCount) return false;
+
+		for(uint64_t i = 0; i < indexCount; i++)
+		{
+			T index;
+			std::memcpy(&index, data + i * sizeof(T), sizeof(T));
+			index = static_cast<T>(index - minIndex);
+			std::memcpy(data + i * sizeof(T), &index, sizeof(T));
+		}
+		firstVertex = minIndex;
+		rangeCount = static_cast<uint64_t>(maxIndex - minIndex) + 1;
+		return true;
+	}
+}
+
 // GFG FILE READER STL
 GFGFileReaderSTL::GFGFileReaderSTL(std::ifstream& fileReader)
 	: reader(fileReader)
@@ -47,6 +129,34 @@ void GFGFileReaderSTL::MovePtrRelative(int64_t relLocation, GFGDirection dir)
 	reader.seekg(relLocation, lookup[static_cast<int>(dir)]);
 }
 
+void GFGFileReaderI::ReadAt(uint8_t buffer[], size_t readAmount, size_t absLocation)
+{
+	MovePtrAbs(absLocation);
+	Read(buffer, readAmount);
+}
+
+void GFGFileReaderI::ReadBatch(const GFGReadRequest requests[], size_t requestCount)
+{
+	for(size_t i = 0; i < requestCount; i++)
+		ReadAt(requests[i].buffer, requests[i].readAmount, requests[i].absLocation);
+}
+
+void GFGFileReaderI::ReadVectoredBatch(const GFGVectoredReadRequest requests[], size_t requestCount)
+{
+	std::vector<GFGReadRequest> reads;
+	for(size_t i = 0; i < requestCount; i++)
+	{
+		size_t location = requests[i].absLocation;
+		for(size_t j = 0; j < requests[i].vectorCount; j++)
+		{
+			const GFGIOVec& vec = requests[i].vectors[j];
+			reads.push_back(GFGReadRequest{vec.buffer, vec.size, location});
+			location += vec.size;
+		}
+	}
+	ReadBatch(reads.data(), reads.size());
+}
+
 size_t GFGFileReaderSTL::GetFileSize()
 {
 	size_t fileSize = 0;
@@ -62,20 +172,53 @@ size_t GFGFileReaderSTL::GetFileSize()
 GFGFileLoader::GFGFileLoader()
 	: header()
 	, reader(nullptr)
+	, fileSize(0)
 	, valid(false)
+	, headerLocation(0)
+	, dataLocation(0)
+	, view()
+	, viewData()
+	, materialized(false)
+	, extensionsDecoded(false)
+	, decodeStates(nullptr)
+	, verifyOnLoad(false)
+	, checksums()
+	, checksumError(GFGFileError::HEADER_EXTENSION_NOT_FOUND)
 {}
 
 GFGFileLoader::GFGFileLoader(GFGFileReaderI* reader)
 	: header()
 	, reader(reader)
+	, fileSize(0)
 	, valid(false)
+	, headerLocation(0)
+	, dataLocation(0)
+	, view()
+	, viewData()
+	, materialized(false)
+	, extensionsDecoded(false)
+	, decodeStates(nullptr)
+	, verifyOnLoad(false)
+	, checksums()
+	, checksumError(GFGFileError::HEADER_EXTENSION_NOT_FOUND)
 {}
 
 GFGFileLoader& GFGFileLoader::operator= (GFGFileLoader&& mv)
 {
-	header.Clear();
+	header = std::move(mv.header);
 	reader = mv.reader;
+	fileSize = mv.fileSize;
 	valid = mv.valid;
+	headerLocation = mv.headerLocation;
+	dataLocation = mv.dataLocation;
+	view = mv.view;
+	viewData = std::move(mv.viewData);
+	materialized = mv.materialized.load();
+	extensionsDecoded = mv.extensionsDecoded.load();
+	decodeStates = std::move(mv.decodeStates);
+	verifyOnLoad = mv.verifyOnLoad;
+	checksums = std::move(mv.checksums);
+	checksumError = mv.checksumError;
 
 	mv.valid = false;
 	mv.reader = nullptr;
@@ -83,288 +226,1100 @@ GFGFileLoader& GFGFileLoader::operator= (GFGFileLoader&& mv)
 	return *this;
 }
 
-GFGFileError GFGFileLoader::ValidateAndOpen()
+void GFGFileLoader::LocateHeader()
 {
-	assert(reader);
+	headerLocation = 0;
+	dataLocation = 0;
+
+	// Appended files end with a trailer that points to the active header
+	GFGHeaderTrailer trailer;
+	if(fileSize < sizeof(GFGHeaderTrailer)) return;
+	reader->ReadAt(reinterpret_cast<uint8_t*>(&trailer), sizeof(GFGHeaderTrailer),
+				   fileSize - sizeof(GFGHeaderTrailer));
+	if(trailer.fourCC != GFGTrailerFourCC ||
+	   trailer.headerLocation >= fileSize - sizeof(GFGHeaderTrailer) ||
+	   trailer.dataLocation > trailer.headerLocation)
+		return;
+
+	// Trailer should point to a header
 	uint32_t fourCC;
-	uint64_t headerSize;
+	reader->ReadAt(reinterpret_cast<uint8_t*>(&fourCC), sizeof(uint32_t), trailer.headerLocation);
+	if(fourCC != GFGFourCC) return;
+
+	headerLocation = trailer.headerLocation;
+	dataLocation = trailer.dataLocation;
+}
+
+GFGFileError GFGFileLoader::ReadHeader(GFGHeaderView& headerView,
+									   std::vector<uint8_t>& headerData) const
+{
+	const uint8_t* mapping = reader->MappedData();
+	if(mapping)
+	{
+		// Header is already in memory validate in place
+		return headerView.Validate(mapping + headerLocation, fileSize - headerLocation);
+	}
 
 	// Get Size Part
-	reader->MovePtrAbs(0);
-	size_t fileSize = reader->GetFileSize();
-	if(sizeof(uint32_t) + sizeof(uint64_t) > fileSize)
+	uint32_t fourCC;
+	uint64_t headerSize;
+	if(sizeof(uint32_t) + sizeof(uint64_t) > fileSize - headerLocation)
 	{
 		// Header Too Small
 		return GFGFileError::FILE_CANNOT_CONTAIN_HEADER;
 	}
-	reader->Read(reinterpret_cast<uint8_t*>(&fourCC), sizeof(uint32_t));
-	reader->Read(reinterpret_cast<uint8_t*>(&headerSize), sizeof(uint64_t));
+	reader->ReadAt(reinterpret_cast<uint8_t*>(&fourCC), sizeof(uint32_t), headerLocation);
+	reader->ReadAt(reinterpret_cast<uint8_t*>(&headerSize), sizeof(uint64_t), headerLocation + sizeof(uint32_t));
 
 	// Check FourCC
 	if(fourCC != GFGFourCC)
-	{
-		// Header Too Small
 		return GFGFileError::FILE_FOURCC_MISMATCH;
-	}
+	if(headerSize > fileSize - headerLocation || headerSize < sizeof(uint32_t) + sizeof(uint64_t))
+		return GFGFileError::FILE_CANNOT_CONTAIN_HEADER;
 
 	// Load Rest of the Header
-	std::vector<uint8_t> headerData(headerSize);
-	if(headerSize > fileSize)
-	{
-		return GFGFileError::FILE_CANNOT_CONTAIN_HEADER;
-	}
+	headerData.resize(headerSize);
 	std::memcpy(headerData.data(), reinterpret_cast<uint8_t*>(&fourCC), sizeof(uint32_t));
 	std::memcpy(headerData.data() + sizeof(uint32_t),
 				reinterpret_cast<uint8_t*>(&headerSize),
 				sizeof(uint64_t));
-	reader->Read(headerData.data() + sizeof(uint32_t) + sizeof(uint64_t),
-				 headerSize - (sizeof(uint32_t) + sizeof(uint64_t)));
-
-	// Seperate Data
-	size_t dataPtr = sizeof(uint32_t) + sizeof(uint64_t);
-
-	// Header Size
-	header.headerSize = headerSize;
-
-	// Transform Jump
-	header.transformJump = *reinterpret_cast<const uint64_t*>(headerData.data() + dataPtr);
-	dataPtr += sizeof(uint64_t);
-
-	// Mesh Jumplist
-	header.meshList.nodeAmount = *reinterpret_cast<const uint32_t*>(headerData.data() + dataPtr);
-	dataPtr += sizeof(uint32_t);
-	header.meshList.meshLocations.resize(header.meshList.nodeAmount);
-	std::memcpy(header.meshList.meshLocations.data(),
-				headerData.data() + dataPtr,
-				header.meshList.nodeAmount * sizeof(uint64_t));
-	dataPtr += header.meshList.nodeAmount * sizeof(uint64_t);
-
-	// Material Jumplist
-	header.materialList.nodeAmount = *reinterpret_cast<const uint32_t*>(headerData.data() + dataPtr);
-	dataPtr += sizeof(uint32_t);
-	header.materialList.materialLocations.resize(header.materialList.nodeAmount);
-	std::memcpy(header.materialList.materialLocations.data(),
-				headerData.data() + dataPtr,
-				header.materialList.nodeAmount * sizeof(uint64_t));
-	dataPtr += header.materialList.nodeAmount * sizeof(uint64_t);
-
-	// Skeleton Jumplist
-	header.skeletonList.nodeAmount = *reinterpret_cast<const uint32_t*>(headerData.data() + dataPtr);
-	dataPtr += sizeof(uint32_t);
-	header.skeletonList.skeletonLocations.resize(header.skeletonList.nodeAmount);
-	std::memcpy(header.skeletonList.skeletonLocations.data(),
-				headerData.data() + dataPtr,
-				header.skeletonList.nodeAmount * sizeof(uint64_t));
-	dataPtr += header.skeletonList.nodeAmount * sizeof(uint64_t);
-
-	// Animation Jumplist
-	header.animationList.nodeAmount = *reinterpret_cast<const uint32_t*>(headerData.data() + dataPtr);
-	dataPtr += sizeof(uint32_t);
-	header.animationList.animationLocations.resize(header.animationList.nodeAmount);
-	std::memcpy(header.animationList.animationLocations.data(),
-				headerData.data() + dataPtr,
-				header.animationList.nodeAmount * sizeof(uint64_t));
-	dataPtr += header.animationList.nodeAmount * sizeof(uint64_t);
-
-	// Scene Hierarchy
-	header.sceneHierarchy.nodeAmount = *reinterpret_cast<const uint32_t*>(headerData.data() + dataPtr);
-	dataPtr += sizeof(uint32_t);
-	header.sceneHierarchy.nodes.resize(header.sceneHierarchy.nodeAmount);
-	std::memcpy(header.sceneHierarchy.nodes.data(),
-				headerData.data() + dataPtr,
-				header.sceneHierarchy.nodeAmount * sizeof(GFGNode));
-	dataPtr += header.sceneHierarchy.nodeAmount * sizeof(GFGNode);
-
-	// MM Pair List
-	header.meshMaterialConnections.meshMatCount = *reinterpret_cast<const uint32_t*>(headerData.data() + dataPtr);
-	dataPtr += sizeof(uint32_t);
-	header.meshMaterialConnections.pairs.resize(header.meshMaterialConnections.meshMatCount);
-	std::memcpy(header.meshMaterialConnections.pairs.data(),
-				headerData.data() + dataPtr,
-				header.meshMaterialConnections.meshMatCount * sizeof(GFGMeshMatPair));
-	dataPtr += header.meshMaterialConnections.meshMatCount * sizeof(GFGMeshMatPair);
-
-	// MS Pair List
-	header.meshSkeletonConnections.meshSkelCount = *reinterpret_cast<const uint32_t*>(headerData.data() + dataPtr);
-	dataPtr += sizeof(uint32_t);
-	header.meshSkeletonConnections.connections.resize(header.meshSkeletonConnections.meshSkelCount);
-	std::memcpy(header.meshSkeletonConnections.connections.data(),
-				headerData.data() + dataPtr,
-				header.meshSkeletonConnections.meshSkelCount * sizeof(GFGMeshSkelPair));
-	dataPtr += header.meshSkeletonConnections.meshSkelCount * sizeof(GFGMeshSkelPair);
-
-	// Meshes
+	reader->ReadAt(headerData.data() + sizeof(uint32_t) + sizeof(uint64_t),
+				   headerSize - (sizeof(uint32_t) + sizeof(uint64_t)),
+				   headerLocation + sizeof(uint32_t) + sizeof(uint64_t));
+	return headerView.Validate(headerData.data(), headerData.size());
+}
+
+GFGFileError GFGFileLoader::ValidateAndOpen(GFGHeaderMode mode)
+{
+	assert(reader);
+	valid = false;
+	view = GFGHeaderView();
+	viewData.clear();
+	materialized = false;
+	extensionsDecoded = false;
+	decodeStates = nullptr;
+	checksums.Clear();
+	checksumError = GFGFileError::HEADER_EXTENSION_NOT_FOUND;
+
+	// File size is fetched once, data functions check against this
+	reader->MovePtrAbs(0);
+	fileSize = reader->GetFileSize();
+	LocateHeader();
+	if(mode == GFGHeaderMode::LAZY) return OpenLazy();
+
+	GFGHeaderView headerView;
+	GFGFileError error = ReadHeader(headerView, viewData);
+	if(error != GFGFileError::OK) return error;
+
+	if(verifyOnLoad)
+	{
+		error = VerifyHeaderView(headerView);
+		if(error != GFGFileError::OK &&
+		   error != GFGFileError::HEADER_EXTENSION_NOT_FOUND)
+			return error;
+	}
+
+	// Header is kept, owning header is filled on access
+	view = headerView;
+	header.Clear();
+	header.headerSize = view.HeaderSize();
+	header.transformJump = view.TransformJump();
+	header.meshList.nodeAmount = view.MeshCount();
+	header.materialList.nodeAmount = view.MaterialCount();
+	header.skeletonList.nodeAmount = view.SkeletonCount();
+	header.animationList.nodeAmount = view.AnimationCount();
+	if(headerLocation == 0) dataLocation = header.headerSize;
+	ReserveSubHeaders();
+
+	// Finished
+	valid = true;
+	return GFGFileError::OK;
+}
+
+void GFGFileLoader::ReserveSubHeaders()
+{
+	// Sub-headers are reserved, filled on access
 	header.meshes.resize(header.meshList.nodeAmount);
-	for(unsigned int i = 0; i < header.meshList.nodeAmount; i++)
+	header.materials.resize(header.materialList.nodeAmount);
+	header.skeletons.resize(header.skeletonList.nodeAmount);
+	header.animations.resize(header.animationList.nodeAmount);
+	size_t subHeaderCount = header.meshes.size() + header.materials.size() +
+							header.skeletons.size() + header.animations.size();
+	decodeStates = std::make_unique<std::atomic<uint8_t>[]>(subHeaderCount);
+}
+
+GFGFileError GFGFileLoader::OpenLazy()
+{
+	header.Clear();
+
+	// FourCC, Header Size and Transform Jump
+	uint8_t prefix[sizeof(uint32_t) + sizeof(uint64_t) * 2];
+	if(sizeof(prefix) > fileSize - headerLocation)
+		return GFGFileError::FILE_CANNOT_CONTAIN_HEADER;
+	reader->ReadAt(prefix, sizeof(prefix), headerLocation);
+
+	uint32_t fourCC;
+	std::memcpy(&fourCC, prefix, sizeof(uint32_t));
+	std::memcpy(&header.headerSize, prefix + sizeof(uint32_t), sizeof(uint64_t));
+	std::memcpy(&header.transformJump, prefix + sizeof(uint32_t) + sizeof(uint64_t), sizeof(uint64_t));
+	if(fourCC != GFGFourCC)
+		return GFGFileError::FILE_FOURCC_MISMATCH;
+	if(header.headerSize > fileSize - headerLocation || header.headerSize < sizeof(prefix))
+		return GFGFileError::FILE_CANNOT_CONTAIN_HEADER;
+	if(headerLocation == 0) dataLocation = header.headerSize;
+
+	// Jump Lists (in order)
+	uint64_t dataPtr = sizeof(prefix);
+	auto ReadJumpList = [&](std::vector<uint64_t>& list, uint32_t& count)
 	{
-		size_t headerLoc = header.meshList.meshLocations[i];
-		std::memcpy(&header.meshes[i].headerCore, headerData.data() + headerLoc, sizeof(GFGMeshHeaderCore));
+		if(!ReadHeaderData(&count, dataPtr, sizeof(uint32_t))) return false;
+		dataPtr += sizeof(uint32_t);
+
+		uint64_t byteSize = static_cast<uint64_t>(count) * sizeof(uint64_t);
+		if(header.headerSize - dataPtr < byteSize) return false;
+		list.resize(count);
+		ReadHeaderData(list.data(), dataPtr, byteSize);
+		dataPtr += byteSize;
+
+		// Locations should be in header
+		for(uint64_t loc : list)
+			if(loc > header.headerSize) return false;
+		return true;
+	};
+	if(!ReadJumpList(header.meshList.meshLocations, header.meshList.nodeAmount) ||
+	   !ReadJumpList(header.materialList.materialLocations, header.materialList.nodeAmount) ||
+	   !ReadJumpList(header.skeletonList.skeletonLocations, header.skeletonList.nodeAmount) ||
+	   !ReadJumpList(header.animationList.animationLocations, header.animationList.nodeAmount))
+	{
+		header.Clear();
+		return GFGFileError::HEADER_CORRUPTED;
+	}
+
+	ReserveSubHeaders();
+	valid = true;
 
-		// Write Components
-		header.meshes[i].components.resize(header.meshes[i].headerCore.componentCount);
-		std::memcpy(header.meshes[i].components.data(),
-					headerData.data() + headerLoc + sizeof(GFGMeshHeaderCore),
-					header.meshes[i].headerCore.componentCount * sizeof(GFGVertexComponent));
+	if(verifyOnLoad)
+	{
+		GFGFileError error = VerifyHeader();
+		if(error != GFGFileError::OK &&
+		   error != GFGFileError::HEADER_EXTENSION_NOT_FOUND)
+		{
+			valid = false;
+			return error;
+		}
 	}
+	return GFGFileError::OK;
+}
 
-	// Materials
-	header.materials.resize(header.materialList.nodeAmount);
-	for(unsigned int i = 0; i < header.materialList.nodeAmount; i++)
+bool GFGFileLoader::ReadHeaderData(void* data, uint64_t location, uint64_t size) const
+{
+	if(location > header.headerSize || header.headerSize - location < size)
+		return false;
+	// Kept header is already validated and in memory
+	if(view.IsValid())
+		std::memcpy(data, view.Data() + location, static_cast<size_t>(size));
+	else
+		reader->ReadAt(static_cast<uint8_t*>(data), size, headerLocation + location);
+	return true;
+}
+
+bool GFGFileLoader::DecodeSubHeader(uint32_t stateIndex) const
+{
+	uint32_t meshCount = header.meshList.nodeAmount;
+	uint32_t materialCount = header.materialList.nodeAmount;
+	uint32_t skeletonCount = header.skeletonList.nodeAmount;
+	if(stateIndex < meshCount)
+	{
+		GFGMeshHeader& mesh = header.meshes[stateIndex];
+		uint64_t loc = view.IsValid() ? view.MeshLocations()[stateIndex]
+									  : header.meshList.meshLocations[stateIndex];
+		GFGMeshHeaderCore core;
+		if(!ReadHeaderData(&core, loc, sizeof(GFGMeshHeaderCore)))
+			return false;
+		loc += sizeof(GFGMeshHeaderCore);
+		uint64_t compSize = static_cast<uint64_t>(core.componentCount) * sizeof(GFGVertexComponent);
+		if(header.headerSize - loc < compSize) return false;
+
+		mesh.headerCore = core;
+		mesh.components.resize(core.componentCount);
+		ReadHeaderData(mesh.components.data(), loc, compSize);
+		return true;
+	}
+	stateIndex -= meshCount;
+	if(stateIndex < materialCount)
+	{
+		GFGMaterialHeader& material = header.materials[stateIndex];
+		uint64_t loc = view.IsValid() ? view.MaterialLocations()[stateIndex]
+									  : header.materialList.materialLocations[stateIndex];
+		GFGMaterialHeaderCore core;
+		if(!ReadHeaderData(&core, loc, sizeof(GFGMaterialHeaderCore)))
+			return false;
+		loc += sizeof(GFGMaterialHeaderCore);
+		uint64_t texSize = static_cast<uint64_t>(core.textureCount) * sizeof(GFGTexturePath);
+		uint64_t uniformSize = static_cast<uint64_t>(core.unifromCount) * sizeof(GFGUniformData);
+		if(header.headerSize - loc < texSize + uniformSize) return false;
+
+		material.headerCore = core;
+		material.textureList.resize(core.textureCount);
+		material.uniformList.resize(core.unifromCount);
+		ReadHeaderData(material.textureList.data(), loc, texSize);
+		ReadHeaderData(material.uniformList.data(), loc + texSize, uniformSize);
+		return true;
+	}
+	stateIndex -= materialCount;
+	if(stateIndex < skeletonCount)
 	{
-		size_t headerLoc = header.materialList.materialLocations[i];
-		std::memcpy(&header.materials[i].headerCore, headerData.data() + headerLoc, sizeof(GFGMaterialHeaderCore));
+		GFGSkeletonHeader& skeleton = header.skeletons[stateIndex];
+		uint64_t loc = view.IsValid() ? view.SkeletonLocations()[stateIndex]
+									  : header.skeletonList.skeletonLocations[stateIndex];
+		uint32_t boneAmount;
+		if(!ReadHeaderData(&boneAmount, loc, sizeof(uint32_t)))
+			return false;
+		loc += sizeof(uint32_t);
+		uint64_t boneSize = static_cast<uint64_t>(boneAmount) * sizeof(GFGBone);
+		if(header.headerSize - loc < boneSize) return false;
+
+		skeleton.boneAmount = boneAmount;
+		skeleton.bones.resize(boneAmount);
+		ReadHeaderData(skeleton.bones.data(), loc, boneSize);
+		return true;
+	}
+	stateIndex -= skeletonCount;
+	return ReadHeaderData(&header.animations[stateIndex],
+						  view.IsValid() ? view.AnimationLocations()[stateIndex]
+										 : header.animationList.animationLocations[stateIndex],
+						  sizeof(GFGAnimationHeader));
+}
+
+void GFGFileLoader::LazyDecode(uint32_t stateIndex) const
+{
+	std::atomic<uint8_t>& state = decodeStates[stateIndex];
+	if(state.load(std::memory_order_acquire) != NOT_DECODED) return;
 
-		// Write Texture Headers
-		header.materials[i].textureList.resize(header.materials[i].headerCore.textureCount);
-		std::memcpy(header.materials[i].textureList.data(),
-					headerData.data() + headerLoc + sizeof(GFGMaterialHeaderCore),
-					header.materials[i].headerCore.textureCount * sizeof(GFGTexturePath));
+	std::lock_guard<std::mutex> lock(lazyMutex);
+	if(state.load(std::memory_order_relaxed) != NOT_DECODED) return;
+	state.store(DecodeSubHeader(stateIndex) ? DECODED : CORRUPTED,
+				std::memory_order_release);
+}
 
-		// Write Uniform Headers
-		header.materials[i].uniformList.resize(header.materials[i].headerCore.unifromCount);
-		std::memcpy(header.materials[i].uniformList.data(),
-					headerData.data() + headerLoc + sizeof(GFGMaterialHeaderCore) +
-					header.materials[i].headerCore.textureCount * sizeof(GFGTexturePath),
-					header.materials[i].headerCore.unifromCount * sizeof(GFGUniformData));
+GFGFileError GFGFileLoader::HeaderView(GFGHeaderView& headerView,
+									   std::vector<uint8_t>& headerData) const
+{
+	assert(valid);
+	if(view.IsValid())
+	{
+		headerView = view;
+		return GFGFileError::OK;
 	}
+	return ReadHeader(headerView, headerData);
+}
 
-	// Skeletons
-	header.skeletons.resize(header.skeletonList.nodeAmount);
-	for(unsigned int i = 0; i < header.skeletonList.nodeAmount; i++)
+GFGFileError GFGFileLoader::MaterializeHeader() const
+{
+	assert(valid);
+	if(materialized.load(std::memory_order_acquire)) return GFGFileError::OK;
+
+	// Sub-headers (already decoded ones are not touched
+	// since user may hold references to them)
+	uint32_t subHeaderCount = MeshCount() + MaterialCount() + SkeletonCount() + AnimationCount();
+	bool corrupted = false;
+	for(uint32_t i = 0; i < subHeaderCount; i++)
 	{
-		size_t headerLoc = header.skeletonList.skeletonLocations[i];
-		std::memcpy(&header.skeletons[i].boneAmount, headerData.data() + headerLoc, sizeof(uint32_t));
+		LazyDecode(i);
+		corrupted |= (decodeStates[i].load(std::memory_order_acquire) == CORRUPTED);
+	}
+	if(corrupted) return GFGFileError::HEADER_CORRUPTED;
+
+	// Hierarchy, Pairs & Transforms
+	std::lock_guard<std::mutex> lock(lazyMutex);
+	if(materialized.load(std::memory_order_relaxed)) return GFGFileError::OK;
 
-		// Write Bone Structs
-		header.skeletons[i].bones.resize(header.skeletons[i].boneAmount);
-		std::memcpy(header.skeletons[i].bones.data(),
-					headerData.data() + headerLoc + sizeof(uint32_t),
-					header.skeletons[i].boneAmount * sizeof(GFGBone));
+	GFGHeaderView headerView = view;
+	std::vector<uint8_t> headerData;
+	if(!view.IsValid())
+	{
+		GFGFileError error = ReadHeader(headerView, headerData);
+		if(error != GFGFileError::OK) return error;
 	}
 
-	// Animation
-	header.animations.resize(header.animationList.nodeAmount);
-	for(unsigned int i = 0; i < header.animationList.nodeAmount; i++)
+	GFGHeader full;
+	headerView.ToHeader(full);
+	// Jump lists are not read on a full open
+	if(view.IsValid())
+	{
+		header.meshList.meshLocations = std::move(full.meshList.meshLocations);
+		header.materialList.materialLocations = std::move(full.materialList.materialLocations);
+		header.skeletonList.skeletonLocations = std::move(full.skeletonList.skeletonLocations);
+		header.animationList.animationLocations = std::move(full.animationList.animationLocations);
+	}
+	header.sceneHierarchy = std::move(full.sceneHierarchy);
+	header.meshMaterialConnections = std::move(full.meshMaterialConnections);
+	header.meshSkeletonConnections = std::move(full.meshSkeletonConnections);
+	header.transformData = std::move(full.transformData);
+	header.bonetransformData = std::move(full.bonetransformData);
+	// User may hold references to the already decoded extensions
+	if(!extensionsDecoded)
 	{
-		size_t headerLoc = header.animationList.animationLocations[i];
-		std::memcpy(&header.animations[i], headerData.data() + headerLoc, sizeof(GFGAnimationHeader));
+		header.extensions = std::move(full.extensions);
+		DecodeChecksums();
 	}
+	extensionsDecoded.store(true, std::memory_order_release);
+	materialized.store(true, std::memory_order_release);
+	return GFGFileError::OK;
+}
 
-	// Transforms
-	dataPtr = header.transformJump;
+void GFGFileLoader::DecodeExtensions() const
+{
+	if(extensionsDecoded.load(std::memory_order_acquire)) return;
+	std::lock_guard<std::mutex> lock(lazyMutex);
+	if(extensionsDecoded.load(std::memory_order_relaxed)) return;
+
+	// Sections till the end of the header
+	// (corrupted sections are dropped)
+	std::vector<GFGHeaderExtension> extensions;
+	auto ReadExtensions = [&]()
+	{
+		// Skip the transform lists
+		uint64_t dataPtr = header.transformJump;
+		for(int i = 0; i < 2; i++)
+		{
+			uint32_t count;
+			if(!ReadHeaderData(&count, dataPtr, sizeof(uint32_t))) return false;
+			dataPtr += sizeof(uint32_t) + static_cast<uint64_t>(count) * sizeof(GFGTransform);
+		}
 
-	// Node Transforms
-	header.transformData.transformAmount = *reinterpret_cast<const uint32_t*>(headerData.data() + dataPtr);
-	dataPtr += sizeof(uint32_t);
-	header.transformData.transforms.resize(header.transformData.transformAmount);
-	std::memcpy(header.transformData.transforms.data(),
-				headerData.data() + dataPtr,
-				header.transformData.transformAmount * sizeof(GFGTransform));
-	dataPtr += header.transformData.transformAmount * sizeof(GFGTransform);
+		while(dataPtr < header.headerSize)
+		{
+			uint32_t tag;
+			uint64_t size;
+			if(!ReadHeaderData(&tag, dataPtr, sizeof(uint32_t)) ||
+			   !ReadHeaderData(&size, dataPtr + sizeof(uint32_t), sizeof(uint64_t)))
+				return false;
+			dataPtr += sizeof(uint32_t) + sizeof(uint64_t);
+			if(dataPtr > header.headerSize || header.headerSize - dataPtr < size)
+				return false;
+
+			GFGHeaderExtension extension;
+			extension.tag = static_cast<GFGExtensionTag>(tag);
+			extension.data.resize(static_cast<size_t>(size));
+			ReadHeaderData(extension.data.data(), dataPtr, size);
+			extensions.push_back(std::move(extension));
+			dataPtr += size;
+		}
+		return true;
+	};
+	if(ReadExtensions()) header.extensions = std::move(extensions);
+	DecodeChecksums();
+	extensionsDecoded.store(true, std::memory_order_release);
+}
 
-	// Bone Transforms
-	header.bonetransformData.transformAmount = *reinterpret_cast<const uint32_t*>(headerData.data() + dataPtr);
-	dataPtr += sizeof(uint32_t);
-	header.bonetransformData.transforms.resize(header.bonetransformData.transformAmount);
-	std::memcpy(header.bonetransformData.transforms.data(),
-				headerData.data() + dataPtr,
-				header.bonetransformData.transformAmount * sizeof(GFGTransform));
-	dataPtr += header.bonetransformData.transformAmount * sizeof(GFGTransform);
+void GFGFileLoader::DecodeChecksums() const
+{
+	const GFGHeaderExtension* extension = header.FindExtension(GFGExtensionTag::CHECKSUMS);
+	if(extension == nullptr)
+		checksumError = GFGFileError::HEADER_EXTENSION_NOT_FOUND;
+	else if(!checksums.Load(extension->data,
+							header.meshList.nodeAmount,
+							header.materialList.nodeAmount,
+							header.animationList.nodeAmount))
+		checksumError = GFGFileError::HEADER_CORRUPTED;
+	else
+		checksumError = GFGFileError::OK;
+}
 
-	// Check that we iterated dataptr properly
-	assert(dataPtr == header.headerSize);
+GFGFileError GFGFileLoader::FetchChecksums() const
+{
+	assert(valid);
+	DecodeExtensions();
+	return checksumError;
+}
 
-	// Finished
-	valid = true;
+GFGFileError GFGFileLoader::VerifyHeaderView(const GFGHeaderView& headerView) const
+{
+	GFGSpan<const uint8_t> payload;
+	if(!headerView.Extension(payload, GFGExtensionTag::CHECKSUMS))
+		return GFGFileError::HEADER_EXTENSION_NOT_FOUND;
+
+	// Table should be the last section, header checksum covers
+	// everything before the table
+	uint64_t checkedSize = headerView.HeaderSize() - payload.size();
+	GFGChecksumTable table;
+	if(payload.data() != headerView.Data() + checkedSize ||
+	   !table.Load(payload, headerView.MeshCount(),
+				   headerView.MaterialCount(),
+				   headerView.AnimationCount()))
+		return GFGFileError::HEADER_CORRUPTED;
+
+	uint32_t checksum = GFGCrc32C(headerView.Data(), checkedSize);
+	return (checksum == table.HeaderChecksum()) ? GFGFileError::OK : GFGFileError::CHECKSUM_MISMATCH;
+}
+
+GFGFileError GFGFileLoader::VerifyBlocks(const uint8_t data[], GFGBlockType type,
+										 uint32_t first, uint32_t count) const
+{
+	if(!verifyOnLoad || count == 0) return GFGFileError::OK;
+	GFGFileError error = FetchChecksums();
+	if(error == GFGFileError::HEADER_EXTENSION_NOT_FOUND) return GFGFileError::OK;
+	if(error != GFGFileError::OK) return error;
+
+	const uint8_t* blockData = data;
+	for(uint32_t i = first; i < first + count; i++)
+	{
+		uint64_t blockSize = BlockSize(type, i);
+		if(GFGCrc32C(blockData, static_cast<size_t>(blockSize)) != checksums.BlockChecksum(type, i))
+			return GFGFileError::CHECKSUM_MISMATCH;
+		blockData += blockSize;
+	}
 	return GFGFileError::OK;
 }
 
+GFGFileError GFGFileLoader::AllBlockData(uint8_t data[], GFGBlockType type, uint32_t count) const
+{
+	// Adjacent blocks are coalesced into a single read, alignment padding
+	// is read over (all blocks of a type is a single read on files that are not streamed)
+	std::vector<GFGBlockRequest> requests(count);
+	for(uint32_t i = 0; i < count; i++)
+	{
+		requests[i] = GFGBlockRequest{type, i, data};
+		data += BlockSize(type, i);
+	}
+	return BlockData(requests.data(), requests.size(), DataAlignment());
+}
+
+void GFGFileLoader::SetVerifyOnLoad(bool verify)
+{
+	verifyOnLoad = verify;
+}
+
+bool GFGFileLoader::VerifyOnLoad() const
+{
+	return verifyOnLoad;
+}
+
+GFGFileError GFGFileLoader::VerifyHeader() const
+{
+	assert(valid);
+	if(view.IsValid()) return VerifyHeaderView(view);
+	GFGHeaderView headerView;
+	std::vector<uint8_t> headerData;
+	GFGFileError error = ReadHeader(headerView, headerData);
+	if(error != GFGFileError::OK) return error;
+	return VerifyHeaderView(headerView);
+}
+
+GFGFileError GFGFileLoader::VerifyBlock(GFGBlockType type, uint32_t index) const
+{
+	uint32_t expected, checksum;
+	GFGFileError error = BlockChecksum(expected, type, index);
+	if(error != GFGFileError::OK) return error;
+	error = BlockRangeChecksum(checksum, type, index, 0, BlockSize(type, index));
+	if(error != GFGFileError::OK) return error;
+	return (checksum == expected) ? GFGFileError::OK : GFGFileError::CHECKSUM_MISMATCH;
+}
+
+GFGFileError GFGFileLoader::BlockChecksum(uint32_t& checksum, GFGBlockType type, uint32_t index) const
+{
+	GFGFileError error = FetchChecksums();
+	if(error != GFGFileError::OK) return error;
+	checksum = checksums.BlockChecksum(type, index);
+	return GFGFileError::OK;
+}
+
+GFGFileError GFGFileLoader::BlockRangeChecksum(uint32_t& checksum, GFGBlockType type, uint32_t index,
+											   uint64_t byteOffset, uint64_t byteCount) const
+{
+	uint64_t blockSize = BlockSize(type, index);
+	if(byteOffset > blockSize || blockSize - byteOffset < byteCount)
+		return GFGFileError::DATA_OFFSET_WRONG;
+	uint64_t start = BlockStart(type, index) + byteOffset;
+
+	// Mapped files are checksummed in place
+	if(reader->MappedData())
+	{
+		GFGSpan<const uint8_t> view;
+		GFGFileError error = DataView(view, start, byteCount);
+		if(error != GFGFileError::OK) return error;
+		checksum = GFGCrc32C(view.data(), view.size());
+		return GFGFileError::OK;
+	}
+
+	std::vector<uint8_t> buffer(static_cast<size_t>(std::min(ChecksumReadSize, byteCount)));
+	checksum = 0;
+	for(uint64_t offset = 0; offset < byteCount; offset += buffer.size())
+	{
+		uint64_t size = std::min<uint64_t>(buffer.size(), byteCount - offset);
+		GFGFileError error = ReadData(buffer.data(), start + offset, size);
+		if(error != GFGFileError::OK) return error;
+		checksum = GFGCrc32C(buffer.data(), static_cast<size_t>(size), checksum);
+	}
+	return GFGFileError::OK;
+}
+
+const GFGHeaderExtension* GFGFileLoader::HeaderExtension(GFGExtensionTag tag) const
+{
+	assert(valid);
+	DecodeExtensions();
+	return header.FindExtension(tag);
+}
+
+GFGFileError GFGFileLoader::SpatialIndex(GFGSpatialIndex& index) const
+{
+	const GFGHeaderExtension* extension = HeaderExtension(GFGExtensionTag::SPATIAL_INDEX);
+	if(extension == nullptr) return GFGFileError::HEADER_EXTENSION_NOT_FOUND;
+	if(!index.Load(extension->data)) return GFGFileError::HEADER_CORRUPTED;
+	return GFGFileError::OK;
+}
+
+uint64_t GFGFileLoader::DataAlignment() const
+{
+	const GFGHeaderExtension* extension = HeaderExtension(GFGExtensionTag::DATA_ALIGNMENT);
+	if(extension == nullptr || extension->data.size() != sizeof(uint64_t)) return 1;
+
+	uint64_t alignment;
+	std::memcpy(&alignment, extension->data.data(), sizeof(uint64_t));
+	return alignment;
+}
+
 const GFGHeader& GFGFileLoader::Header() const
 {
 	assert(valid);
+	// Partially decoded header is never returned
+	static const GFGHeader emptyHeader = GFGHeader();
+	if(MaterializeHeader() != GFGFileError::OK) return emptyHeader;
 	return header;
 }
 
-GFGFileError GFGFileLoader::MeshVertexData(uint8_t data[], uint32_t meshIndex)
+uint32_t GFGFileLoader::MeshCount() const
+{
+	assert(valid);
+	return header.meshList.nodeAmount;
+}
+
+uint32_t GFGFileLoader::MaterialCount() const
+{
+	assert(valid);
+	return header.materialList.nodeAmount;
+}
+
+uint32_t GFGFileLoader::SkeletonCount() const
+{
+	assert(valid);
+	return header.skeletonList.nodeAmount;
+}
+
+uint32_t GFGFileLoader::AnimationCount() const
+{
+	assert(valid);
+	return header.animationList.nodeAmount;
+}
+
+const GFGMeshHeader& GFGFileLoader::MeshHeader(uint32_t meshIndex) const
 {
 	assert(meshIndex < header.meshList.nodeAmount);
+	LazyDecode(meshIndex);
+	return header.meshes[meshIndex];
+}
+
+const GFGMaterialHeader& GFGFileLoader::MaterialHeader(uint32_t materialIndex) const
+{
+	assert(materialIndex < header.materialList.nodeAmount);
+	LazyDecode(MeshCount() + materialIndex);
+	return header.materials[materialIndex];
+}
+
+const GFGSkeletonHeader& GFGFileLoader::SkeletonHeader(uint32_t skeletonIndex) const
+{
+	assert(skeletonIndex < header.skeletonList.nodeAmount);
+	LazyDecode(MeshCount() + MaterialCount() + skeletonIndex);
+	return header.skeletons[skeletonIndex];
+}
+
+const GFGAnimationHeader& GFGFileLoader::AnimationHeader(uint32_t animIndex) const
+{
+	assert(animIndex < header.animationList.nodeAmount);
+	LazyDecode(MeshCount() + MaterialCount() + SkeletonCount() + animIndex);
+	return header.animations[animIndex];
+}
+
+bool GFGFileLoader::IsConcurrent() const
+{
+	return reader && reader->IsReadAtThreadSafe();
+}
+
+uint64_t GFGFileLoader::HeaderLocation() const
+{
 	assert(valid);
-	if(header.headerSize + header.meshes[meshIndex].headerCore.vertexStart >= reader->GetFileSize())
-		return GFGFileError::DATA_OFFSET_WRONG;
+	return headerLocation;
+}
 
-	reader->MovePtrAbs(header.headerSize + header.meshes[meshIndex].headerCore.vertexStart);
-	size_t readAmount = MeshVertexDataSize(meshIndex);
-	reader->Read(data, readAmount);
-	return GFGFileError::OK;
+uint64_t GFGFileLoader::DataLocation() const
+{
+	assert(valid);
+	return dataLocation;
 }
 
-GFGFileError GFGFileLoader::AllMeshVertexData(uint8_t data[])
+uint64_t GFGFileLoader::FileSize() const
 {
 	assert(valid);
-	if(header.headerSize + header.meshes[0].headerCore.vertexStart >= reader->GetFileSize())
+	return fileSize;
+}
+
+GFGFileError GFGFileLoader::ReadData(uint8_t data[], uint64_t dataStart, uint64_t dataSize) const
+{
+	assert(valid);
+	uint64_t start = dataLocation + dataStart;
+	if(start > fileSize || fileSize - start < dataSize)
 		return GFGFileError::DATA_OFFSET_WRONG;
 
-	reader->MovePtrAbs(header.headerSize + header.meshes[0].headerCore.vertexStart);
-	size_t readAmount = AllMeshVertexDataSize();
-	reader->Read(data, readAmount);
+	reader->ReadAt(data, dataSize, start);
 	return GFGFileError::OK;
 }
 
-GFGFileError GFGFileLoader::MeshIndexData(uint8_t data[], uint32_t meshIndex)
+GFGFileError GFGFileLoader::MeshVertexData(uint8_t data[], uint32_t meshIndex) const
 {
 	assert(meshIndex < header.meshList.nodeAmount);
+	GFGFileError error = ReadData(data,
+								  MeshHeader(meshIndex).headerCore.vertexStart,
+								  MeshVertexDataSize(meshIndex));
+	if(error != GFGFileError::OK) return error;
+	return VerifyBlocks(data, GFGBlockType::MESH_VERTEX, meshIndex, 1);
+}
+
+GFGFileError GFGFileLoader::AllMeshVertexData(uint8_t data[]) const
+{
 	assert(valid);
-	if(header.headerSize + header.meshes[meshIndex].headerCore.vertexStart >= reader->GetFileSize())
-		return GFGFileError::DATA_OFFSET_WRONG;
+	if(header.meshList.nodeAmount == 0) return GFGFileError::OK;
+	return AllBlockData(data, GFGBlockType::MESH_VERTEX, MeshCount());
+}
 
-	reader->MovePtrAbs(header.headerSize + header.meshes[meshIndex].headerCore.indexStart);
-	size_t readAmount = MeshIndexDataSize(meshIndex);
-	reader->Read(data, readAmount);
-	return GFGFileError::OK;
+GFGFileError GFGFileLoader::MeshIndexData(uint8_t data[], uint32_t meshIndex) const
+{
+	assert(meshIndex < header.meshList.nodeAmount);
+	GFGFileError error = ReadData(data,
+								  MeshHeader(meshIndex).headerCore.indexStart,
+								  MeshIndexDataSize(meshIndex));
+	if(error != GFGFileError::OK) return error;
+	return VerifyBlocks(data, GFGBlockType::MESH_INDEX, meshIndex, 1);
 }
 
-GFGFileError GFGFileLoader::AllMeshIndexData(uint8_t data[])
+GFGFileError GFGFileLoader::AllMeshIndexData(uint8_t data[]) const
 {
 	assert(valid);
-	if(header.headerSize + header.meshes[0].headerCore.vertexStart >= reader->GetFileSize())
+	if(header.meshList.nodeAmount == 0) return GFGFileError::OK;
+	return AllBlockData(data, GFGBlockType::MESH_INDEX, MeshCount());
+}
+
+GFGFileError GFGFileLoader::MeshIndexDataRange(uint8_t data[], uint32_t meshIndex,
+											   uint64_t firstIndex, uint64_t indexCount) const
+{
+	assert(meshIndex < header.meshList.nodeAmount);
+	const GFGMeshHeaderCore& core = MeshHeader(meshIndex).headerCore;
+	if(firstIndex > core.indexCount || core.indexCount - firstIndex < indexCount)
 		return GFGFileError::DATA_OFFSET_WRONG;
+	return ReadData(data,
+					core.indexStart + firstIndex * core.indexSize,
+					indexCount * core.indexSize);
+}
 
-	reader->MovePtrAbs(header.headerSize + header.meshes[0].headerCore.indexStart);
-	size_t readAmount = AllMeshIndexDataSize();
-	reader->Read(data, readAmount);
-	return GFGFileError::OK;
+uint64_t GFGFileLoader::MeshIndexDataRangeSize(uint32_t meshIndex, uint64_t indexCount) const
+{
+	assert(meshIndex < header.meshList.nodeAmount);
+	return indexCount * MeshHeader(meshIndex).headerCore.indexSize;
 }
 
-GFGFileError GFGFileLoader::MeshVertexComponentDataGroup(uint8_t data[], uint32_t meshIndex,
-														 GFGVertexComponentLogic logic)
+GFGFileError GFGFileLoader::MeshVertexDataRange(uint8_t data[], uint32_t meshIndex,
+												uint64_t firstVertex, uint64_t vertexCount) const
 {
 	assert(meshIndex < header.meshList.nodeAmount);
 	assert(valid);
-	const auto& meshHeader = header.meshes[meshIndex];
 
-	size_t componentStart = header.headerSize + meshHeader.headerCore.vertexStart;
+	const GFGMeshHeader& mesh = MeshHeader(meshIndex);
+	if(firstVertex > mesh.headerCore.vertexCount ||
+	   mesh.headerCore.vertexCount - firstVertex < vertexCount)
+		return GFGFileError::DATA_OFFSET_WRONG;
+	if(vertexCount == 0) return GFGFileError::OK;
+
+	// Slice of each group is written after the previous group's slice
+	std::vector<VertexGroup> groups = VertexGroups(mesh.components);
+	std::vector<GFGBlockRangeRequest> requests(groups.size());
+	uint64_t outOffset = 0;
+	for(size_t i = 0; i < groups.size(); i++)
+	{
+		requests[i] = GFGBlockRangeRequest
+		{
+			GFGBlockType::MESH_VERTEX,
+			meshIndex,
+			groups[i].startOffset + firstVertex * groups[i].stride,
+			(vertexCount - 1) * groups[i].stride + groups[i].elementEnd,
+			data + outOffset
+		};
+		outOffset += GroupRangeSize(groups[i], vertexCount);
+	}
+	return BlockDataRanges(requests.data(), requests.size());
+}
+
+uint64_t GFGFileLoader::MeshVertexDataRangeSize(uint32_t meshIndex, uint64_t vertexCount) const
+{
+	assert(meshIndex < header.meshList.nodeAmount);
+	uint64_t size = 0;
+	for(const VertexGroup& g : VertexGroups(MeshHeader(meshIndex).components))
+		size += GroupRangeSize(g, vertexCount);
+	return size;
+}
+
+std::vector<GFGVertexComponent> GFGFileLoader::MeshVertexDataRangeLayout(uint32_t meshIndex,
+																		 uint64_t vertexCount) const
+{
+	assert(meshIndex < header.meshList.nodeAmount);
+	const std::vector<GFGVertexComponent>& components = MeshHeader(meshIndex).components;
+	std::vector<VertexGroup> groups = VertexGroups(components);
+
+	std::vector<GFGVertexComponent> layout = components;
+	for(GFGVertexComponent& c : layout)
+	{
+		uint64_t outOffset = 0;
+		for(const VertexGroup& g : groups)
+		{
+			if(g.startOffset == c.startOffset)
+			{
+				c.stride = g.stride;
+				break;
+			}
+			outOffset += GroupRangeSize(g, vertexCount);
+		}
+		c.startOffset = outOffset;
+	}
+	return layout;
+}
+
+GFGFileError GFGFileLoader::MeshMaterialPairIndexData(uint8_t indexData[],
+													  uint64_t& firstVertex, uint64_t& vertexCount,
+													  const GFGMeshMatPair& pair) const
+{
+	assert(pair.meshIndex < header.meshList.nodeAmount);
+	const GFGMeshHeaderCore& core = MeshHeader(pair.meshIndex).headerCore;
+
+	// Non-indexed mesh, pair holds the vertex range
+	if(core.indexCount == 0)
+	{
+		if(pair.indexOffset > core.vertexCount || core.vertexCount - pair.indexOffset < pair.indexCount)
+			return GFGFileError::DATA_OFFSET_WRONG;
+		firstVertex = pair.indexOffset;
+		vertexCount = pair.indexCount;
+		return GFGFileError::OK;
+	}
+
+	firstVertex = 0;
+	vertexCount = 0;
+	GFGFileError e = MeshIndexDataRange(indexData, pair.meshIndex, pair.indexOffset, pair.indexCount);
+	if(e != GFGFileError::OK || pair.indexCount == 0) return e;
+
+	bool inRange = false;
+	switch(core.indexSize)
+	{
+		case 1: inRange = RebaseIndices<uint8_t>(indexData, pair.indexCount, core.vertexCount, firstVertex, vertexCount); break;
+		case 2: inRange = RebaseIndices<uint16_t>(indexData, pair.indexCount, core.vertexCount, firstVertex, vertexCount); break;
+		case 4: inRange = RebaseIndices<uint32_t>(indexData, pair.indexCount, core.vertexCount, firstVertex, vertexCount); break;
+		case 8: inRange = RebaseIndices<uint64_t>(indexData, pair.indexCount, core.vertexCount, firstVertex, vertexCount); break;
+		default: assert(false); break;
+	}
+	return inRange ? GFGFileError::OK : GFGFileError::DATA_OFFSET_WRONG;
+}
+
+uint64_t GFGFileLoader::MeshMaterialPairIndexDataSize(const GFGMeshMatPair& pair) const
+{
+	assert(pair.meshIndex < header.meshList.nodeAmount);
+	if(MeshHeader(pair.meshIndex).headerCore.indexCount == 0) return 0;
+	return MeshIndexDataRangeSize(pair.meshIndex, pair.indexCount);
+}
+
+GFGFileError GFGFileLoader::MeshMaterialPairData(std::vector<uint8_t>& indexData,
+												 std::vector<uint8_t>& vertexData,
+												 uint64_t& firstVertex,
+												 const GFGMeshMatPair& pair) const
+{
+	uint64_t vertexCount;
+	indexData.resize(static_cast<size_t>(MeshMaterialPairIndexDataSize(pair)));
+	GFGFileError e = MeshMaterialPairIndexData(indexData.data(), firstVertex, vertexCount, pair);
+	if(e != GFGFileError::OK) return e;
+
+	vertexData.resize(static_cast<size_t>(MeshVertexDataRangeSize(pair.meshIndex, vertexCount)));
+	return MeshVertexDataRange(vertexData.data(), pair.meshIndex, firstVertex, vertexCount);
+}
+
+GFGFileError GFGFileLoader::VertexComponentGroupOffset(uint64_t& offset, uint32_t meshIndex,
+													   GFGVertexComponentLogic logic) const
+{
+	assert(meshIndex < header.meshList.nodeAmount);
+	assert(valid);
 
 	// Find the component offset
+	for(const auto& comp : MeshHeader(meshIndex).components)
+	{
+		if(comp.logic != logic) continue;
+		offset = comp.startOffset;
+		return GFGFileError::OK;
+	}
+	return GFGFileError::MESH_DOES_NOT_HAVE_THAT_LOGIC;
+}
+
+GFGFileError GFGFileLoader::MeshVertexComponentDataGroup(uint8_t data[], uint32_t meshIndex,
+														 GFGVertexComponentLogic logic) const
+{
+	uint64_t offset;
+	GFGFileError e = VertexComponentGroupOffset(offset, meshIndex, logic);
+	if(e != GFGFileError::OK) return e;
+
 	size_t readAmount = MeshVertexComponentDataGroupSize(meshIndex, logic);
-	for(const auto& comp : meshHeader.components)
+	return ReadData(data, MeshHeader(meshIndex).headerCore.vertexStart + offset, readAmount);
+}
+
+const GFGVertexComponent* GFGFileLoader::FindComponent(uint32_t meshIndex,
+													   GFGVertexComponentLogic logic,
+													   uint32_t setIndex) const
+{
+	for(const GFGVertexComponent& comp : MeshHeader(meshIndex).components)
 	{
 		if(comp.logic != logic) continue;
+		if(setIndex == 0) return &comp;
+		setIndex--;
+	}
+	return nullptr;
+}
+
+uint64_t GFGFileLoader::MeshVertexComponentDataSize(uint32_t meshIndex,
+													GFGVertexComponentLogic logic,
+													uint32_t setIndex) const
+{
+	assert(meshIndex < header.meshList.nodeAmount);
+	assert(valid);
+
+	const GFGVertexComponent* comp = FindComponent(meshIndex, logic, setIndex);
+	if(comp == nullptr) return 0;
+	return GFGDataTypeByteSize[static_cast<uint32_t>(comp->dataType)] *
+		   MeshHeader(meshIndex).headerCore.vertexCount;
+}
 
-		componentStart += comp.startOffset;
-		// Move file ptr and memcpy to the buffer
-		reader->MovePtrAbs(componentStart);
-		reader->Read(data, readAmount);
+GFGFileError GFGFileLoader::MeshVertexComponentData(uint8_t data[], uint32_t meshIndex,
+													GFGVertexComponentLogic logic,
+													uint32_t setIndex) const
+{
+	assert(meshIndex < header.meshList.nodeAmount);
+	assert(valid);
+
+	const GFGVertexComponent* comp = FindComponent(meshIndex, logic, setIndex);
+	if(comp == nullptr) return GFGFileError::MESH_DOES_NOT_HAVE_THAT_LOGIC;
+
+	const GFGMeshHeaderCore& core = MeshHeader(meshIndex).headerCore;
+	uint64_t elementSize = GFGDataTypeByteSize[static_cast<uint32_t>(comp->dataType)];
+	uint64_t stride = GFGComponentStride(*comp);
+	uint64_t vertexCount = core.vertexCount;
+	if(vertexCount == 0) return GFGFileError::OK;
+
+	// Component has to reside in the vertex block
+	uint64_t start = comp->startOffset + comp->internalOffset;
+	uint64_t span = (vertexCount - 1) * stride + elementSize;
+	uint64_t blockSize = MeshVertexDataSize(meshIndex);
+	if(start > blockSize || blockSize - start < span)
+		return GFGFileError::DATA_OFFSET_WRONG;
+	start += core.vertexStart;
+
+	// Mapped file, gather directly from the mapping
+	GFGSpan<const uint8_t> view;
+	if(DataView(view, start, span) == GFGFileError::OK)
+	{
+		GFGStridedCopy(data, elementSize, view.data(), stride, elementSize, vertexCount);
 		return GFGFileError::OK;
 	}
-	return GFGFileError::MESH_DOES_NOT_HAVE_THAT_LOGIC;
+
+	// Read the group in chunks and gather
+	uint64_t chunkVertexCount = std::max<uint64_t>(1, ComponentGatherChunkSize / std::max<uint64_t>(stride, 1));
+	std::vector<uint8_t> chunk;
+	for(uint64_t i = 0; i < vertexCount; i += chunkVertexCount)
+	{
+		uint64_t count = std::min(chunkVertexCount, vertexCount - i);
+		uint64_t chunkSpan = (count - 1) * stride + elementSize;
+		chunk.resize(chunkSpan);
+
+		GFGFileError e = ReadData(chunk.data(), start + i * stride, chunkSpan);
+		if(e != GFGFileError::OK) return e;
+		GFGStridedCopy(data + i * elementSize, elementSize,
+					   chunk.data(), stride, elementSize, count);
+	}
+	return GFGFileError::OK;
 }
+
+uint64_t GFGFileLoader::MeshVertexDataTranscodedSize(uint32_t meshIndex,
+													 const std::vector<GFGVertexComponent>& layout) const
+{
+	assert(meshIndex < header.meshList.nodeAmount);
+	assert(valid);
+
+	uint64_t vertexCount = MeshHeader(meshIndex).headerCore.vertexCount;
+	if(vertexCount == 0) return 0;
+
+	uint64_t result = 0;
+	for(const GFGVertexComponent& comp : layout)
+	{
+		uint64_t elementSize = GFGDataTypeByteSize[static_cast<uint32_t>(comp.dataType)];
+		uint64_t stride = GFGComponentStride(comp);
+		uint64_t end = comp.startOffset + comp.internalOffset +
+					   (vertexCount - 1) * stride + elementSize;
+		result = std::max(result, end);
+	}
+	return result;
+}
+
+GFGFileError GFGFileLoader::MeshVertexDataTranscoded(uint8_t data[], uint32_t meshIndex,
+													 const std::vector<GFGVertexComponent>& layout) const
+{
+	assert(meshIndex < header.meshList.nodeAmount);
+	assert(valid);
+
+	const GFGMeshHeaderCore& core = MeshHeader(meshIndex).headerCore;
+	uint64_t vertexCount = core.vertexCount;
+	uint64_t blockSize = MeshVertexDataSize(meshIndex);
+
+	// Match layout components with the mesh components
+	std::vector<const GFGVertexComponent*> sources(layout.size());
+	for(size_t i = 0; i < layout.size(); i++)
+	{
+		uint32_t setIndex = 0;
+		for(size_t j = 0; j < i; j++)
+			if(layout[j].logic == layout[i].logic) setIndex++;
+
+		const GFGVertexComponent* src = FindComponent(meshIndex, layout[i].logic, setIndex);
+		if(src == nullptr) return GFGFileError::MESH_DOES_NOT_HAVE_THAT_LOGIC;
+		if(!GFGConversions::IsStreamConvertible(layout[i].dataType, src->dataType))
+			return GFGFileError::DATA_TYPE_MISMATCH;
+		sources[i] = src;
+	}
+
+	// Source groups (components that share a start offset share the stride)
+	// only groups that are used by the layout are read
+	struct Group
+	{
+		uint64_t	startOffset;
+		uint64_t	stride;
+		uint64_t	elementEnd;		// Furthest used byte in a single element
+		size_t		scratchOffset;
+	};
+	std::vector<Group> groups;
+	std::vector<size_t> sourceGroups(layout.size());
+	for(size_t i = 0; i < layout.size(); i++)
+	{
+		const GFGVertexComponent& src = *sources[i];
+		uint64_t end = src.internalOffset + GFGDataTypeByteSize[static_cast<uint32_t>(src.dataType)];
+		auto it = std::find_if(groups.begin(), groups.end(), [&](const Group& g)
+		{
+			return g.startOffset == src.startOffset;
+		});
+		if(it == groups.end())
+		{
+			groups.push_back(Group{src.startOffset, GFGComponentStride(src), end, 0});
+			it = groups.end() - 1;
+		}
+		it->elementEnd = std::max(it->elementEnd, end);
+		sourceGroups[i] = static_cast<size_t>(it - groups.begin());
+	}
+	uint64_t totalStride = 0;
+	for(const Group& g : groups)
+		totalStride += std::max(g.stride, g.elementEnd);
+
+	// Components have to reside in the vertex block
+	for(size_t i = 0; i < layout.size(); i++)
+	{
+		uint64_t start = sources[i]->startOffset + sources[i]->internalOffset;
+		uint64_t span = (vertexCount == 0) ? 0 : (vertexCount - 1) * groups[sourceGroups[i]].stride +
+					    GFGDataTypeByteSize[static_cast<uint32_t>(sources[i]->dataType)];
+		if(start > blockSize || blockSize - start < span)
+			return GFGFileError::DATA_OFFSET_WRONG;
+	}
+	if(vertexCount == 0 || layout.empty()) return GFGFileError::OK;
+
+	std::vector<uint64_t> layoutStrides(layout.size());
+	for(size_t i = 0; i < layout.size(); i++)
+		layoutStrides[i] = GFGComponentStride(layout[i]);
+
+	// Mapped file, single pass from the mapping
+	GFGSpan<const uint8_t> view;
+	if(DataView(view, core.vertexStart, blockSize) == GFGFileError::OK)
+	{
+		for(size_t i = 0; i < layout.size(); i++)
+		{
+			GFGConversions::ConvertStream(data + layout[i].startOffset + layout[i].internalOffset,
+										  layoutStrides[i], layout[i].dataType,
+										  view.data() + sources[i]->startOffset + sources[i]->internalOffset,
+										  groups[sourceGroups[i]].stride, sources[i]->dataType,
+										  vertexCount);
+		}
+		return GFGFileError::OK;
+	}
+
+	// Read groups chunk by chunk (single batch per chunk) and transcode
+	uint64_t chunkVertexCount = std::max<uint64_t>(1, ComponentGatherChunkSize / std::max<uint64_t>(totalStride, 1));
+	std::vector<uint8_t> scratch;
+	std::vector<GFGBlockRangeRequest> requests(groups.size());
+	for(uint64_t i = 0; i < vertexCount; i += chunkVertexCount)
+	{
+		uint64_t count = std::min(chunkVertexCount, vertexCount - i);
+		size_t scratchSize = 0;
+		for(size_t g = 0; g < groups.size(); g++)
+		{
+			groups[g].scratchOffset = scratchSize;
+			scratchSize += static_cast<size_t>((count - 1) * groups[g].stride + groups[g].elementEnd);
+		}
+		scratch.resize(scratchSize);
+		for(size_t g = 0; g < groups.size(); g++)
+		{
+			requests[g] = GFGBlockRangeRequest
+			{
+				GFGBlockType::MESH_VERTEX,
+				meshIndex,
+				groups[g].startOffset + i * groups[g].stride,
+				(count - 1) * groups[g].stride + groups[g].elementEnd,
+				scratch.data() + groups[g].scratchOffset
+			};
+		}
+		GFGFileError e = BlockDataRanges(requests.data(), requests.size());
+		if(e != GFGFileError::OK) return e;
+
+		for(size_t k = 0; k < layout.size(); k++)
+		{
+			const Group& g = groups[sourceGroups[k]];
+			GFGConversions::ConvertStream(data + layout[k].startOffset + layout[k].internalOffset + i * layoutStrides[k],
+										  layoutStrides[k], layout[k].dataType,
+										  scratch.data() + g.scratchOffset + sources[k]->internalOffset,
+										  g.stride, sources[k]->dataType,
+										  count);
+		}
+	}
+	return GFGFileError::OK;
+}
+
+GFGFileError GFGFileLoader::MeshVertexComponentDataGroupRequest(GFGBlockRangeRequest& request,
+																uint8_t data[], uint32_t meshIndex,
+																GFGVertexComponentLogic logic) const
+{
+	uint64_t offset;
+	GFGFileError e = VertexComponentGroupOffset(offset, meshIndex, logic);
+	if(e != GFGFileError::OK) return e;
+
+	request.type = GFGBlockType::MESH_VERTEX;
+	request.index = meshIndex;
+	request.byteOffset = offset;
+	request.byteCount = MeshVertexComponentDataGroupSize(meshIndex, logic);
+	request.data = data;
+	return GFGFileError::OK;
+}
+
 size_t GFGFileLoader::MeshVertexComponentDataGroupSize(uint32_t meshIndex,
-													   GFGVertexComponentLogic logic)
+													   GFGVertexComponentLogic logic) const
 {
 	assert(meshIndex < header.meshList.nodeAmount);
 	assert(valid);
 
-	const auto& meshHeader = header.meshes[meshIndex];
+	const auto& meshHeader = MeshHeader(meshIndex);
 	// Check all components with the same start offset
 	// first find the start offset
 	size_t startOffset = std::numeric_limits<size_t>::max();
@@ -388,78 +1343,55 @@ size_t GFGFileLoader::MeshVertexComponentDataGroupSize(uint32_t meshIndex,
 	return bytePerVert * meshHeader.headerCore.vertexCount;
 }
 
-GFGFileError GFGFileLoader::MaterialTextureData(uint8_t data[], uint32_t materialIndex)
+GFGFileError GFGFileLoader::MaterialTextureData(uint8_t data[], uint32_t materialIndex) const
 {
 	assert(materialIndex < header.materialList.nodeAmount);
-	assert(valid);
-	if(header.headerSize + header.materials[materialIndex].headerCore.textureStart >= reader->GetFileSize())
-		return GFGFileError::DATA_OFFSET_WRONG;
-
-	reader->MovePtrAbs(header.headerSize + header.materials[materialIndex].headerCore.textureStart);
-	size_t readAmount = MaterialTextureDataSize(materialIndex);
-	reader->Read(data, readAmount);
-	return GFGFileError::OK;
+	GFGFileError error = ReadData(data,
+								  MaterialHeader(materialIndex).headerCore.textureStart,
+								  MaterialTextureDataSize(materialIndex));
+	if(error != GFGFileError::OK) return error;
+	return VerifyBlocks(data, GFGBlockType::MATERIAL_TEXTURE, materialIndex, 1);
 }
 
-GFGFileError GFGFileLoader::AllMaterialTextureData(uint8_t data[])
+GFGFileError GFGFileLoader::AllMaterialTextureData(uint8_t data[]) const
 {
 	assert(valid);
-	if(header.headerSize + header.materials[0].headerCore.textureStart >= reader->GetFileSize())
-		return GFGFileError::DATA_OFFSET_WRONG;
-
-	reader->MovePtrAbs(header.headerSize + header.materials[0].headerCore.textureStart);
-	size_t readAmount = AllMaterialTextureDataSize();
-	reader->Read(data, readAmount);
-	return GFGFileError::OK;
+	if(header.materialList.nodeAmount == 0) return GFGFileError::OK;
+	return AllBlockData(data, GFGBlockType::MATERIAL_TEXTURE, MaterialCount());
 }
 
-GFGFileError GFGFileLoader::MaterialUniformData(uint8_t data[], uint32_t materialIndex)
+GFGFileError GFGFileLoader::MaterialUniformData(uint8_t data[], uint32_t materialIndex) const
 {
 	assert(materialIndex < header.materialList.nodeAmount);
-	if(header.headerSize + header.materials[materialIndex].headerCore.uniformStart >= reader->GetFileSize())
-		return GFGFileError::DATA_OFFSET_WRONG;
-
-	reader->MovePtrAbs(header.headerSize + header.materials[materialIndex].headerCore.uniformStart);
-	size_t readAmount = MaterialUniformDataSize(materialIndex);
-	reader->Read(data, readAmount);
-	return GFGFileError::OK;
+	GFGFileError error = ReadData(data,
+								  MaterialHeader(materialIndex).headerCore.uniformStart,
+								  MaterialUniformDataSize(materialIndex));
+	if(error != GFGFileError::OK) return error;
+	return VerifyBlocks(data, GFGBlockType::MATERIAL_UNIFORM, materialIndex, 1);
 }
 
-GFGFileError GFGFileLoader::AllMaterialUniformData(uint8_t data[])
+GFGFileError GFGFileLoader::AllMaterialUniformData(uint8_t data[]) const
 {
 	assert(valid);
-	if(header.headerSize + header.materials[0].headerCore.uniformStart >= reader->GetFileSize())
-		return GFGFileError::DATA_OFFSET_WRONG;
-
-	reader->MovePtrAbs(header.headerSize + header.materials[0].headerCore.uniformStart);
-	size_t readAmount = AllMaterialUniformDataSize();
-	reader->Read(data, readAmount);
-	return GFGFileError::OK;
+	if(header.materialList.nodeAmount == 0) return GFGFileError::OK;
+	return AllBlockData(data, GFGBlockType::MATERIAL_UNIFORM, MaterialCount());
 }
 
-GFGFileError GFGFileLoader::AnimationKeyframeData(uint8_t data[], uint32_t animIndex)
+GFGFileError GFGFileLoader::AnimationKeyframeData(uint8_t data[], uint32_t animIndex) const
 {
 	assert(animIndex < header.animationList.nodeAmount);
-	assert(valid);
-	if(header.headerSize + header.animations[animIndex].dataStart >= reader->GetFileSize())
-		return GFGFileError::DATA_OFFSET_WRONG;
-
-	reader->MovePtrAbs(header.headerSize + header.animations[animIndex].dataStart);
-	size_t readAmount = AnimationKeyframeDataSize(animIndex);
-	reader->Read(reinterpret_cast<uint8_t*>(data), readAmount);
-	return GFGFileError::OK;
+	GFGFileError error = ReadData(data,
+								  AnimationHeader(animIndex).dataStart,
+								  AnimationKeyframeDataSize(animIndex));
+	if(error != GFGFileError::OK) return error;
+	return VerifyBlocks(data, GFGBlockType::ANIMATION_KEYFRAME, animIndex, 1);
 }
 
-GFGFileError GFGFileLoader::AllAnimationKeyframeData(uint8_t data[])
+GFGFileError GFGFileLoader::AllAnimationKeyframeData(uint8_t data[]) const
 {
 	assert(valid);
-	if(header.headerSize + header.animations[0].dataStart >= reader->GetFileSize())
-		return GFGFileError::DATA_OFFSET_WRONG;
-
-	reader->MovePtrAbs(header.headerSize + header.animations[0].dataStart);
-	size_t readAmount = AllAnimationKeyframeDataSize();
-	reader->Read(reinterpret_cast<uint8_t*>(data), readAmount);
-	return GFGFileError::OK;
+	if(header.animationList.nodeAmount == 0) return GFGFileError::OK;
+	return AllBlockData(data, GFGBlockType::ANIMATION_KEYFRAME, AnimationCount());
 }
 
 uint64_t GFGFileLoader::MeshVertexDataSize(uint32_t meshIndex) const
@@ -469,11 +1401,11 @@ uint64_t GFGFileLoader::MeshVertexDataSize(uint32_t meshIndex) const
 
 	// Get Total Component Size
 	uint64_t componentSizes = 0;
-	for(const GFGVertexComponent& component : header.meshes[meshIndex].components)
+	for(const GFGVertexComponent& component : MeshHeader(meshIndex).components)
 	{
 		componentSizes += GFGDataTypeByteSize[static_cast<uint32_t>(component.dataType)];
 	}
-	return componentSizes * header.meshes[meshIndex].headerCore.vertexCount;
+	return componentSizes * MeshHeader(meshIndex).headerCore.vertexCount;
 }
 
 uint64_t GFGFileLoader::AllMeshVertexDataSize() const
@@ -481,8 +1413,9 @@ uint64_t GFGFileLoader::AllMeshVertexDataSize() const
 	assert(valid);
 
 	uint64_t result = 0;
-	for(const GFGMeshHeader& mesh : header.meshes)
+	for(uint32_t i = 0; i < header.meshList.nodeAmount; i++)
 	{
+		const GFGMeshHeader& mesh = MeshHeader(i);
 		// Get Total Component Size Per Mesh
 		uint64_t componentSizes = 0;
 		for(const GFGVertexComponent& component : mesh.components)
@@ -499,7 +1432,7 @@ uint64_t GFGFileLoader::MeshIndexDataSize(uint32_t meshIndex) const
 	assert(meshIndex < header.meshList.nodeAmount);
 	assert(valid);
 
-	return header.meshes[meshIndex].headerCore.indexSize * header.meshes[meshIndex].headerCore.indexCount;
+	return MeshHeader(meshIndex).headerCore.indexSize * MeshHeader(meshIndex).headerCore.indexCount;
 }
 
 uint64_t GFGFileLoader::AllMeshIndexDataSize() const
@@ -507,8 +1440,9 @@ uint64_t GFGFileLoader::AllMeshIndexDataSize() const
 	assert(valid);
 
 	uint64_t result = 0;
-	for(const GFGMeshHeader& mesh : header.meshes)
+	for(uint32_t i = 0; i < header.meshList.nodeAmount; i++)
 	{
+		const GFGMeshHeader& mesh = MeshHeader(i);
 		result += mesh.headerCore.indexSize * mesh.headerCore.indexCount;
 	}
 	return result;
@@ -520,7 +1454,7 @@ uint64_t GFGFileLoader::MaterialTextureDataSize(uint32_t materialIndex) const
 	assert(valid);
 
 	uint64_t result = 0;
-	for(const GFGTexturePath& texPaths : header.materials[materialIndex].textureList)
+	for(const GFGTexturePath& texPaths : MaterialHeader(materialIndex).textureList)
 	{
 		result += texPaths.stringSize;
 	}
@@ -532,8 +1466,9 @@ uint64_t GFGFileLoader::AllMaterialTextureDataSize() const
 	assert(valid);
 
 	uint64_t result = 0;
-	for(const GFGMaterialHeader& material : header.materials)
+	for(uint32_t i = 0; i < header.materialList.nodeAmount; i++)
 	{
+		const GFGMaterialHeader& material = MaterialHeader(i);
 		for(const GFGTexturePath& texPaths : material.textureList)
 		{
 			result += texPaths.stringSize;
@@ -548,7 +1483,7 @@ uint64_t GFGFileLoader::MaterialUniformDataSize(uint32_t materialIndex) const
 	assert(valid);
 
 	uint64_t result = 0;
-	for(const GFGUniformData& uniforms : header.materials[materialIndex].uniformList)
+	for(const GFGUniformData& uniforms : MaterialHeader(materialIndex).uniformList)
 	{
 		result += GFGDataTypeByteSize[static_cast<uint32_t>(uniforms.dataType)];
 	}
@@ -560,8 +1495,9 @@ uint64_t GFGFileLoader::AllMaterialUniformDataSize() const
 	assert(valid);
 
 	uint64_t result = 0;
-	for(const GFGMaterialHeader& material : header.materials)
+	for(uint32_t i = 0; i < header.materialList.nodeAmount; i++)
 	{
+		const GFGMaterialHeader& material = MaterialHeader(i);
 		for(const GFGUniformData& uniforms : material.uniformList)
 		{
 			result += GFGDataTypeByteSize[static_cast<uint32_t>(uniforms.dataType)];
@@ -575,13 +1511,13 @@ uint64_t GFGFileLoader::AnimationKeyframeDataSize(uint32_t animIndex) const
 	assert(animIndex < header.animationList.nodeAmount);
 	assert(valid);
 
-	uint64_t dataSize = header.animations[animIndex].keyCount *
+	uint64_t dataSize = AnimationHeader(animIndex).keyCount *
 						sizeof(float[4]) *
-						header.skeletons[header.animations[animIndex].skeletonIndex].boneAmount;
-	dataSize += header.animations[animIndex].keyCount * sizeof(float);				// Time
+						SkeletonHeader(AnimationHeader(animIndex).skeletonIndex).boneAmount;
+	dataSize += AnimationHeader(animIndex).keyCount * sizeof(float);				// Time
 
-	if(header.animations[animIndex].type == GFGAnimType::WITH_HIP_TRANSLATE)
-		dataSize += header.animations[animIndex].keyCount * sizeof(float[3]);		// Hip Translate for each Key
+	if(AnimationHeader(animIndex).type == GFGAnimType::WITH_HIP_TRANSLATE)
+		dataSize += AnimationHeader(animIndex).keyCount * sizeof(float[3]);		// Hip Translate for each Key
 	return dataSize;
 }
 
@@ -592,10 +1528,243 @@ uint64_t GFGFileLoader::AllAnimationKeyframeDataSize()const
 	uint64_t result = 0;
 	if(header.animationList.nodeAmount != 0)
 	{
-		for(size_t i = 0; i < header.animations.size(); i++)
+		for(size_t i = 0; i < header.animationList.nodeAmount; i++)
 		{
 			result += AnimationKeyframeDataSize(static_cast<uint32_t>(i));
 		}
 	}
 	return result;
+}
+
+uint64_t GFGFileLoader::BlockStart(GFGBlockType type, uint32_t index) const
+{
+	assert(valid);
+	switch(type)
+	{
+		case GFGBlockType::MESH_VERTEX:
+			assert(index < header.meshList.nodeAmount);
+			return MeshHeader(index).headerCore.vertexStart;
+		case GFGBlockType::MESH_INDEX:
+			assert(index < header.meshList.nodeAmount);
+			return MeshHeader(index).headerCore.indexStart;
+		case GFGBlockType::MATERIAL_TEXTURE:
+			assert(index < header.materialList.nodeAmount);
+			return MaterialHeader(index).headerCore.textureStart;
+		case GFGBlockType::MATERIAL_UNIFORM:
+			assert(index < header.materialList.nodeAmount);
+			return MaterialHeader(index).headerCore.uniformStart;
+		case GFGBlockType::ANIMATION_KEYFRAME:
+			assert(index < header.animationList.nodeAmount);
+			return AnimationHeader(index).dataStart;
+	}
+	return 0;
+}
+
+uint64_t GFGFileLoader::BlockSize(GFGBlockType type, uint32_t index) const
+{
+	switch(type)
+	{
+		case GFGBlockType::MESH_VERTEX:			return MeshVertexDataSize(index);
+		case GFGBlockType::MESH_INDEX:			return MeshIndexDataSize(index);
+		case GFGBlockType::MATERIAL_TEXTURE:	return MaterialTextureDataSize(index);
+		case GFGBlockType::MATERIAL_UNIFORM:	return MaterialUniformDataSize(index);
+		case GFGBlockType::ANIMATION_KEYFRAME:	return AnimationKeyframeDataSize(index);
+	}
+	return 0;
+}
+
+void GFGFileLoader::SharedBlocks(std::vector<uint32_t>& firstIndices, GFGBlockType type) const
+{
+	assert(valid);
+	uint32_t count = 0;
+	switch(type)
+	{
+		case GFGBlockType::MESH_VERTEX:
+		case GFGBlockType::MESH_INDEX:			count = MeshCount(); break;
+		case GFGBlockType::MATERIAL_TEXTURE:
+		case GFGBlockType::MATERIAL_UNIFORM:	count = MaterialCount(); break;
+		case GFGBlockType::ANIMATION_KEYFRAME:	count = AnimationCount(); break;
+	}
+
+	// Shared blocks have the same start and size
+	std::map<std::pair<uint64_t, uint64_t>, uint32_t> firstBlocks;
+	firstIndices.resize(count);
+	for(uint32_t i = 0; i < count; i++)
+	{
+		uint64_t size = BlockSize(type, i);
+		if(size == 0)
+		{
+			firstIndices[i] = i;
+			continue;
+		}
+		auto key = std::make_pair(BlockStart(type, i), size);
+		firstIndices[i] = firstBlocks.emplace(key, i).first->second;
+	}
+}
+
+GFGFileError GFGFileLoader::BlockDataRange(uint8_t data[], GFGBlockType type, uint32_t index,
+										   uint64_t byteOffset, uint64_t byteCount) const
+{
+	uint64_t blockSize = BlockSize(type, index);
+	if(byteOffset > blockSize || blockSize - byteOffset < byteCount)
+		return GFGFileError::DATA_OFFSET_WRONG;
+	return ReadData(data, BlockStart(type, index) + byteOffset, byteCount);
+}
+
+GFGFileError GFGFileLoader::BlockData(const GFGBlockRequest requests[], size_t requestCount,
+									  uint64_t maxGap) const
+{
+	std::vector<GFGBlockRangeRequest> ranges(requestCount);
+	for(size_t i = 0; i < requestCount; i++)
+	{
+		ranges[i] = GFGBlockRangeRequest
+		{
+			requests[i].type,
+			requests[i].index,
+			0,
+			BlockSize(requests[i].type, requests[i].index),
+			requests[i].data
+		};
+	}
+	GFGFileError error = BlockDataRanges(ranges.data(), ranges.size(), maxGap);
+	if(error != GFGFileError::OK) return error;
+	for(size_t i = 0; i < requestCount; i++)
+	{
+		error = VerifyBlocks(requests[i].data, requests[i].type, requests[i].index, 1);
+		if(error != GFGFileError::OK) return error;
+	}
+	return GFGFileError::OK;
+}
+
+GFGFileError GFGFileLoader::BlockDataRanges(const GFGBlockRangeRequest requests[], size_t requestCount,
+											uint64_t maxGap) const
+{
+	assert(valid);
+	struct Range
+	{
+		uint64_t	start;
+		uint64_t	size;
+		uint8_t*	data;
+	};
+
+	// Absolute ranges
+	std::vector<Range> ranges;
+	ranges.reserve(requestCount);
+	for(size_t i = 0; i < requestCount; i++)
+	{
+		const GFGBlockRangeRequest& r = requests[i];
+		uint64_t blockSize = BlockSize(r.type, r.index);
+		if(r.byteOffset > blockSize || blockSize - r.byteOffset < r.byteCount)
+			return GFGFileError::DATA_OFFSET_WRONG;
+
+		uint64_t start = dataLocation + BlockStart(r.type, r.index) + r.byteOffset;
+		if(start > fileSize || fileSize - start < r.byteCount)
+			return GFGFileError::DATA_OFFSET_WRONG;
+		if(r.byteCount == 0) continue;
+		ranges.push_back(Range{start, r.byteCount, r.data});
+	}
+	if(ranges.empty()) return GFGFileError::OK;
+	std::sort(ranges.begin(), ranges.end(), [](const Range& a, const Range& b)
+	{
+		return a.start < b.start;
+	});
+
+	// Coalesce, gaps are read to a scratch buffer (contents are discarded
+	// so all gaps share the same buffer)
+	std::vector<uint8_t> scratch;
+	std::vector<size_t> gaps;
+	std::vector<GFGIOVec> vectors;
+	std::vector<std::pair<size_t, size_t>> groups;	// First vector, absLocation
+	uint64_t groupEnd = 0;
+	for(const Range& r : ranges)
+	{
+		// Overlapping ranges can not be in the same scatter read
+		bool merge = !groups.empty() &&
+					 r.start >= groupEnd &&
+					 r.start - groupEnd <= maxGap;
+		if(merge && r.start > groupEnd)
+		{
+			uint64_t gap = r.start - groupEnd;
+			if(scratch.size() < gap) scratch.resize(gap);
+			gaps.push_back(vectors.size());
+			vectors.push_back(GFGIOVec{nullptr, gap});
+		}
+		else if(!merge)
+			groups.emplace_back(vectors.size(), r.start);
+
+		vectors.push_back(GFGIOVec{r.data, r.size});
+		groupEnd = r.start + r.size;
+	}
+	// Scratch is resized during generation, assign its pointer afterwards
+	for(size_t i : gaps) vectors[i].buffer = scratch.data();
+
+	std::vector<GFGVectoredReadRequest> reads(groups.size());
+	for(size_t i = 0; i < groups.size(); i++)
+	{
+		size_t end = (i + 1 < groups.size()) ? groups[i + 1].first : vectors.size();
+		reads[i] = GFGVectoredReadRequest
+		{
+			vectors.data() + groups[i].first,
+			end - groups[i].first,
+			groups[i].second
+		};
+	}
+	reader->ReadVectoredBatch(reads.data(), reads.size());
+	return GFGFileError::OK;
+}
+
+GFGFileError GFGFileLoader::DataView(GFGSpan<const uint8_t>& view,
+									 uint64_t dataStart, uint64_t dataSize) const
+{
+	assert(valid);
+	const uint8_t* mapping = reader->MappedData();
+	if(mapping == nullptr)
+		return GFGFileError::READER_NOT_MAPPED;
+
+	uint64_t start = dataLocation + dataStart;
+	if(start > fileSize || fileSize - start < dataSize)
+		return GFGFileError::DATA_OFFSET_WRONG;
+
+	view = GFGSpan<const uint8_t>(mapping + start, dataSize);
+	return GFGFileError::OK;
+}
+
+GFGFileError GFGFileLoader::MeshVertexDataView(GFGSpan<const uint8_t>& view, uint32_t meshIndex) const
+{
+	assert(meshIndex < header.meshList.nodeAmount);
+	GFGFileError error = DataView(view,
+								  MeshHeader(meshIndex).headerCore.vertexStart,
+								  MeshVertexDataSize(meshIndex));
+	if(error != GFGFileError::OK) return error;
+	return VerifyBlocks(view.data(), GFGBlockType::MESH_VERTEX, meshIndex, 1);
+}
+
+GFGFileError GFGFileLoader::MeshIndexDataView(GFGSpan<const uint8_t>& view, uint32_t meshIndex) const
+{
+	assert(meshIndex < header.meshList.nodeAmount);
+	GFGFileError error = DataView(view,
+								  MeshHeader(meshIndex).headerCore.indexStart,
+								  MeshIndexDataSize(meshIndex));
+	if(error != GFGFileError::OK) return error;
+	return VerifyBlocks(view.data(), GFGBlockType::MESH_INDEX, meshIndex, 1);
+}
+
+GFGFileError GFGFileLoader::MaterialUniformDataView(GFGSpan<const uint8_t>& view, uint32_t materialIndex) const
+{
+	assert(materialIndex < header.materialList.nodeAmount);
+	GFGFileError error = DataView(view,
+								  MaterialHeader(materialIndex).headerCore.uniformStart,
+								  MaterialUniformDataSize(materialIndex));
+	if(error != GFGFileError::OK) return error;
+	return VerifyBlocks(view.data(), GFGBlockType::MATERIAL_UNIFORM, materialIndex, 1);
+}
+
+GFGFileError GFGFileLoader::AnimationKeyframeDataView(GFGSpan<const uint8_t>& view, uint32_t animIndex) const
+{
+	assert(animIndex < header.animationList.nodeAmount);
+	GFGFileError error = DataView(view,
+								  AnimationHeader(animIndex).dataStart,
+								  AnimationKeyframeDataSize(animIndex));
+	if(error != GFGFileError::OK) return error;
+	return VerifyBlocks(view.data(), GFGBlockType::ANIMATION_KEYFRAME, animIndex, 1);
 }
\ No newline at end of file
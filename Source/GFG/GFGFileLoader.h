@@ -11,8 +11,38 @@ GFGGFileReaderI provides required file io functions needed by the
 file loader. You can use your favourice file handling library or
 you can used the already implemented STL one.
 
+GFGReadRequest holds a single positional read, a batch of these can be
+given to the reader at once (GFGFileReaderI::ReadBatch) so that
+asynchronous readers (i.e. GFGFileReaderIOUring) can issue them together.
+GFGVectoredReadRequest reads a contiguous file range into multiple buffers
+(scatter read), loader uses it to coalesce nearby blocks into a single read.
+
 GFGFileLoader is used to fetch data from GFG File.
 
+On a full open (GFGHeaderMode::FULL) whole header is validated once
+(GFGHeaderView) and kept, in place on mapped readers or in a single buffer
+otherwise. Owning header structures are not built on open, sub-headers
+(mesh, material, skeleton, animation) are copied from the kept header on
+first access (MeshHeader(i) etc.) and Header() materializes the rest.
+
+Loader can also open the file lazily (GFGHeaderMode::LAZY); only the fixed
+part of the header and the jump lists are read on open and sub-headers are
+read from the file on first access.
+
+Loader only reads data through GFGFileReaderI::ReadAt (positional read).
+If the reader's ReadAt is thread safe (i.e. GFGFileReaderPOSIX, GFGFileReaderMMap)
+after ValidateAndOpen, header is immutable and all data functions can be
+called concurrently from multiple threads without locking.
+
+Loader can verify the CRC32C checksums (GFGChecksumTable) of the file
+inline with the reads (SetVerifyOnLoad). Header is verified on open and
+whole block reads are verified right after the read while the data is
+still in cache. A full file scrub that verifies the blocks in parallel
+is available on GFGParallelLoader.
+
+Files that are appended (GFGHeaderTrailer) are detected on open, header is
+loaded from the location that the trailer points to.
+
 GFGFileError Enumerations holds errors can happen during validation,
 or data fetch operations.
 
@@ -24,8 +54,37 @@ https://github.com/yalcinerbora/GFGFileFormat/blob/master/LICENSE
 #define __GFG_FILELOADER_H__
 
 #include "GFGHeader.h"
+#include "GFGHeaderView.h"
+#include "GFGChecksum.h"
 #include "GFGEnumerations.h"
+#include "GFGSpan.h"
+#include <atomic>
 #include <fstream>
+#include <memory>
+#include <mutex>
+
+// Single positional read
+struct GFGReadRequest
+{
+	uint8_t*		buffer;
+	size_t			readAmount;
+	size_t			absLocation;
+};
+
+// Scatter read, reads a contiguous file range
+// starting from "absLocation" to the buffers in order
+struct GFGIOVec
+{
+	uint8_t*		buffer;
+	size_t			size;
+};
+
+struct GFGVectoredReadRequest
+{
+	const GFGIOVec*	vectors;
+	size_t			vectorCount;
+	size_t			absLocation;
+};
 
 // TODO: maybe user does not want to include <fstream>
 // Seperation of File Reading and Layout of the file
@@ -38,6 +97,25 @@ class GFGFileReaderI
 		virtual void	MovePtrAbs(size_t absLocation) = 0;
 		virtual void	MovePtrRelative(int64_t relLocation, GFGDirection) = 0;
 		virtual size_t	GetFileSize() = 0;
+
+		// Positional read, reads from the absolute location
+		// Default implementation moves the file pointer then reads
+		// thus it is not thread safe
+		virtual void	ReadAt(uint8_t buffer[], size_t readAmount, size_t absLocation);
+		// Implementations should return true if ReadAt can be called
+		// concurrently from multiple threads
+		virtual bool	IsReadAtThreadSafe() const { return false; }
+		// Issues multiple positional reads, returns when all of them are completed
+		// Default implementation calls ReadAt for each request
+		virtual void	ReadBatch(const GFGReadRequest requests[], size_t requestCount);
+		// Issues multiple scatter reads, returns when all of them are completed
+		// Default implementation splits them to a single ReadBatch
+		virtual void	ReadVectoredBatch(const GFGVectoredReadRequest requests[], size_t requestCount);
+
+		// Readers that map the file to the address space
+		// can return the mapping so that loader can give views
+		// instead of copying the data. nullptr if not mapped.
+		virtual const uint8_t*	MappedData() { return nullptr; }
 };
 
 class GFGFileReaderSTL : public GFGFileReaderI
@@ -56,6 +134,8 @@ class GFGFileReaderSTL : public GFGFileReaderI
 		size_t	GetFileSize() override;
 };
 
+class GFGSpatialIndex;
+
 // GFG File Errors
 enum class GFGFileError
 {
@@ -63,7 +143,37 @@ enum class GFGFileError
 	FILE_CANNOT_CONTAIN_HEADER, 	// HeaderSize > FileSize
 	DATA_OFFSET_WRONG,				// Absolute data offset > FileSize
 	FILE_FOURCC_MISMATCH,			// FourCC code is not 'GFG '
-	MESH_DOES_NOT_HAVE_THAT_LOGIC	// Mesh does not have the requested logic
+	MESH_DOES_NOT_HAVE_THAT_LOGIC,	// Mesh does not have the requested logic
+	READER_NOT_MAPPED,				// View requested but reader does not map the file
+	HEADER_CORRUPTED,				// Header internal offset/size is out of header bounds
+	DATA_TYPE_MISMATCH,				// Transcode requires a data type conversion that is not supported
+	HEADER_EXTENSION_NOT_FOUND,		// File does not have the requested header extension
+	CHECKSUM_MISMATCH				// Data or header does not match its stored checksum
+};
+
+// Header loading behaviour of the GFGFileLoader
+enum class GFGHeaderMode
+{
+	FULL,		// Whole header is validated and kept on open, sub-headers are decoded on access
+	LAZY		// Only jump lists are read on open, sub-headers are read on access
+};
+
+// Whole block read, used for batched loading
+struct GFGBlockRequest
+{
+	GFGBlockType	type;
+	uint32_t		index;
+	uint8_t*		data;
+};
+
+// Partial block read ("byteCount" bytes starting from "byteOffset" of the block)
+struct GFGBlockRangeRequest
+{
+	GFGBlockType	type;
+	uint32_t		index;
+	uint64_t		byteOffset;
+	uint64_t		byteCount;
+	uint8_t*		data;
 };
 
 class GFGFileLoader
@@ -72,9 +182,61 @@ class GFGFileLoader
 		static size_t					EmptyHeaderSize;
 
 		// Properties
-		GFGHeader						header;
+		// Mutable since sub-headers are decoded on demand in lazy mode
+		mutable GFGHeader				header;
 		GFGFileReaderI*					reader;
+		size_t							fileSize;
 		bool							valid;
+		// Absolute locations of the header and the data start
+		// (header is at the end of the file on appended files)
+		uint64_t						headerLocation;
+		uint64_t						dataLocation;
+
+		// Validated header of a full open (refer to GFGHeaderView)
+		// Points to the mapping on mapped readers, to "viewData" otherwise
+		GFGHeaderView					view;
+		std::vector<uint8_t>			viewData;
+
+		// On Demand Header
+		// Sub-header decode state (meshes, materials, skeletons then animations)
+		mutable std::atomic<bool>		materialized;
+		mutable std::atomic<bool>		extensionsDecoded;
+		mutable std::mutex				lazyMutex;
+		mutable std::unique_ptr<std::atomic<uint8_t>[]>	decodeStates;
+
+		// Checksums
+		// Error holds the table state (OK, HEADER_EXTENSION_NOT_FOUND or HEADER_CORRUPTED)
+		bool							verifyOnLoad;
+		mutable GFGChecksumTable		checksums;
+		mutable GFGFileError			checksumError;
+
+		void							LocateHeader();
+		GFGFileError					ReadHeader(GFGHeaderView&, std::vector<uint8_t>& headerData) const;
+		GFGFileError					OpenLazy();
+		void							ReserveSubHeaders();
+		bool							ReadHeaderData(void* data, uint64_t location, uint64_t size) const;
+		bool							DecodeSubHeader(uint32_t stateIndex) const;
+		void							LazyDecode(uint32_t stateIndex) const;
+		void							DecodeExtensions() const;
+		void							DecodeChecksums() const;
+		GFGFileError					FetchChecksums() const;
+		GFGFileError					VerifyHeaderView(const GFGHeaderView&) const;
+		// Verifies "count" consecutive blocks starting from "first" that are read
+		// back to back to "data"
+		// (no-op if verify on load is disabled or file does not have checksums)
+		GFGFileError					VerifyBlocks(const uint8_t data[], GFGBlockType,
+													 uint32_t first, uint32_t count) const;
+		// Reads all blocks of a type back to back, blocks do not need to be
+		// adjacent in the file (streamed files interleave block types)
+		GFGFileError					AllBlockData(uint8_t data[], GFGBlockType, uint32_t count) const;
+
+		GFGFileError					ReadData(uint8_t data[], uint64_t dataStart, uint64_t dataSize) const;
+		GFGFileError					DataView(GFGSpan<const uint8_t>& view,
+												 uint64_t dataStart, uint64_t dataSize) const;
+		GFGFileError					VertexComponentGroupOffset(uint64_t& offset, uint32_t meshIndex,
+																   GFGVertexComponentLogic) const;
+		const GFGVertexComponent*		FindComponent(uint32_t meshIndex, GFGVertexComponentLogic,
+													  uint32_t setIndex) const;
 
 	protected:
 
@@ -88,17 +250,106 @@ class GFGFileLoader
 										~GFGFileLoader() = default;
 
 		// Header Access
+		// Materializes the whole header on first call, returns an empty header
+		// if it can not be materialized (lazy mode, call MaterializeHeader
+		// first and check its result)
 		const GFGHeader&				Header() const;
+		// Decodes the rest of the header
+		// Returns HEADER_CORRUPTED if any of the sub-headers is corrupted (lazy mode)
+		GFGFileError					MaterializeHeader() const;
+		// Validated in-place view of the header (refer to GFGHeaderView)
+		// After a full open this is the kept header and "headerData" is not used,
+		// in lazy mode header is validated again (in place on mapped readers,
+		// read to "headerData" otherwise, view is valid while it lives)
+		GFGFileError					HeaderView(GFGHeaderView&, std::vector<uint8_t>& headerData) const;
+
+		uint32_t						MeshCount() const;
+		uint32_t						MaterialCount() const;
+		uint32_t						SkeletonCount() const;
+		uint32_t						AnimationCount() const;
+
+		// Sub-header Access (decoded on first access in lazy mode)
+		// Corrupted sub-headers are returned empty
+		const GFGMeshHeader&			MeshHeader(uint32_t meshIndex) const;
+		const GFGMaterialHeader&		MaterialHeader(uint32_t materialIndex) const;
+		const GFGSkeletonHeader&		SkeletonHeader(uint32_t skeletonIndex) const;
+		const GFGAnimationHeader&		AnimationHeader(uint32_t animIndex) const;
+
+		// Header Extensions (decoded on first access in lazy mode)
+		// Returns nullptr if the file does not have the extension
+		const GFGHeaderExtension*		HeaderExtension(GFGExtensionTag) const;
+		// Loads the spatial index (SPATIAL_INDEX extension) of the file
+		// Index can then be queried for the nodes/meshes in a region
+		GFGFileError					SpatialIndex(GFGSpatialIndex&) const;
+		// Guaranteed alignment of the data block file offsets (DATA_ALIGNMENT extension)
+		// 1 if the file does not have the extension
+		uint64_t						DataAlignment() const;
+
+		// Checksums (CHECKSUMS extension, refer to GFGChecksumTable)
+		// When enabled (before ValidateAndOpen) header is verified on open
+		// and whole block reads (MeshVertexData, All..., BlockData, views)
+		// are verified after the read. Partial reads (ranges, components,
+		// transcoding) are not verified. Files without checksums are loaded
+		// without verification. In lazy mode the whole header is read on open
+		// for verification.
+		void							SetVerifyOnLoad(bool);
+		bool							VerifyOnLoad() const;
+		// Returns HEADER_EXTENSION_NOT_FOUND if the file does not have checksums
+		GFGFileError					VerifyHeader() const;
+		GFGFileError					VerifyBlock(GFGBlockType, uint32_t index) const;
+		// Stored checksum of the block and the checksum of a block range
+		// that is read from the file (ranges can be combined with GFGCrc32CCombine)
+		static constexpr uint64_t		ChecksumReadSize = 1024 * 1024;
+		GFGFileError					BlockChecksum(uint32_t& checksum, GFGBlockType, uint32_t index) const;
+		GFGFileError					BlockRangeChecksum(uint32_t& checksum, GFGBlockType, uint32_t index,
+														   uint64_t byteOffset, uint64_t byteCount) const;
+
+		// True if data functions can be called concurrently
+		// (depends on the reader)
+		bool							IsConcurrent() const;
+
+		// Layout
+		// Absolute location of the header (non-zero on appended files)
+		uint64_t						HeaderLocation() const;
+		// Absolute location that the block starts are relative to
+		uint64_t						DataLocation() const;
+		uint64_t						FileSize() const;
 
 		// Exporting
-		GFGFileError					ValidateAndOpen();
+		GFGFileError					ValidateAndOpen(GFGHeaderMode = GFGHeaderMode::FULL);
 
 		// Data Segment Export
 		// Mesh Importing
-		GFGFileError					MeshVertexData(uint8_t data[], uint32_t meshIndex);
-		GFGFileError					AllMeshVertexData(uint8_t data[]);
-		GFGFileError					MeshIndexData(uint8_t data[], uint32_t meshIndex);
-		GFGFileError					AllMeshIndexData(uint8_t data[]);
+		GFGFileError					MeshVertexData(uint8_t data[], uint32_t meshIndex) const;
+		GFGFileError					AllMeshVertexData(uint8_t data[]) const;
+		GFGFileError					MeshIndexData(uint8_t data[], uint32_t meshIndex) const;
+		GFGFileError					AllMeshIndexData(uint8_t data[]) const;
+		// Loading a sub-range of a mesh
+		// Loads "indexCount" indices starting from "firstIndex"
+		GFGFileError					MeshIndexDataRange(uint8_t data[], uint32_t meshIndex,
+														   uint64_t firstIndex, uint64_t indexCount) const;
+		uint64_t						MeshIndexDataRangeSize(uint32_t meshIndex, uint64_t indexCount) const;
+		// Loads "vertexCount" vertices starting from "firstVertex"
+		// Each component group (components that share a start offset) is sliced
+		// and groups are written back to back in start offset order.
+		// MeshVertexDataRangeLayout returns the components of the written data
+		GFGFileError					MeshVertexDataRange(uint8_t data[], uint32_t meshIndex,
+															uint64_t firstVertex, uint64_t vertexCount) const;
+		uint64_t						MeshVertexDataRangeSize(uint32_t meshIndex, uint64_t vertexCount) const;
+		std::vector<GFGVertexComponent>	MeshVertexDataRangeLayout(uint32_t meshIndex, uint64_t vertexCount) const;
+		// Loading a single mesh/material pair (submesh)
+		// Loads the index slice of the pair, indices are rebased to the first vertex
+		// that is referenced by the slice and the referenced vertex range is returned
+		// (for non-indexed meshes pair holds the vertex range, no index data is written)
+		GFGFileError					MeshMaterialPairIndexData(uint8_t indexData[],
+																  uint64_t& firstVertex, uint64_t& vertexCount,
+																  const GFGMeshMatPair&) const;
+		uint64_t						MeshMaterialPairIndexDataSize(const GFGMeshMatPair&) const;
+		// Loads the index slice and the referenced vertex range (MeshVertexDataRange) of the pair
+		GFGFileError					MeshMaterialPairData(std::vector<uint8_t>& indexData,
+															 std::vector<uint8_t>& vertexData,
+															 uint64_t& firstVertex,
+															 const GFGMeshMatPair&) const;
 		// Loading "Structure of Arrays" segments
 		// If pos & normal is packed
 		// For Example:
@@ -114,22 +365,50 @@ class GFGFileLoader
 		// If you call this  function with GFGVertexComponent::POSITION or ::NORMAL
 		// this function will write all of the posNormal array to the data pointer
 		GFGFileError					MeshVertexComponentDataGroup(uint8_t data[], uint32_t meshIndex,
-													   				 GFGVertexComponentLogic);
+													   				 GFGVertexComponentLogic) const;
 		size_t							MeshVertexComponentDataGroupSize(uint32_t meshIndex,
-													   				     GFGVertexComponentLogic);
+													   				     GFGVertexComponentLogic) const;
+		// Loading a single component to a packed array
+		// Component is gathered from its group using its offsets & stride
+		// "setIndex" selects between components with the same logic (i.e. multiple UV sets)
+		static constexpr uint64_t		ComponentGatherChunkSize = 1024 * 1024;
+		GFGFileError					MeshVertexComponentData(uint8_t data[], uint32_t meshIndex,
+																GFGVertexComponentLogic,
+																uint32_t setIndex = 0) const;
+		uint64_t						MeshVertexComponentDataSize(uint32_t meshIndex,
+																	GFGVertexComponentLogic,
+																	uint32_t setIndex = 0) const;
+		// Loading vertex data in a different layout (transcoding)
+		// Each component in the "layout" is fetched from the component with the same logic
+		// (n'th component with the same logic in the layout maps to the n'th in the mesh)
+		// and written to "data + startOffset + internalOffset + vertexIndex * stride"
+		// (zero stride is tightly packed, same for the mesh components).
+		// Components that are not in the layout are dropped, bytes that are not covered
+		// by the layout are not touched.
+		// If the layout data type differs, component is converted
+		// (refer to GFGConversions::ConvertStream for the supported conversions)
+		GFGFileError					MeshVertexDataTranscoded(uint8_t data[], uint32_t meshIndex,
+																 const std::vector<GFGVertexComponent>& layout) const;
+		uint64_t						MeshVertexDataTranscodedSize(uint32_t meshIndex,
+																	 const std::vector<GFGVertexComponent>& layout) const;
+		// Generates a block range request for the component group
+		// (to be used with BlockDataRanges)
+		GFGFileError					MeshVertexComponentDataGroupRequest(GFGBlockRangeRequest&,
+																			uint8_t data[], uint32_t meshIndex,
+																			GFGVertexComponentLogic) const;
 
 		// Material Importing
-		GFGFileError					MaterialTextureData(uint8_t data[], uint32_t materialIndex);
-		GFGFileError					AllMaterialTextureData(uint8_t data[]);
-		GFGFileError					MaterialUniformData(uint8_t data[], uint32_t materialIndex);
-		GFGFileError					AllMaterialUniformData(uint8_t data[]);
+		GFGFileError					MaterialTextureData(uint8_t data[], uint32_t materialIndex) const;
+		GFGFileError					AllMaterialTextureData(uint8_t data[]) const;
+		GFGFileError					MaterialUniformData(uint8_t data[], uint32_t materialIndex) const;
+		GFGFileError					AllMaterialUniformData(uint8_t data[]) const;
 
 		// Skeleton Importing
 		// Skeleton Does not have data segment
 
 		// Animation Importing
-		GFGFileError					AnimationKeyframeData(uint8_t data[], uint32_t animIndex);
-		GFGFileError					AllAnimationKeyframeData(uint8_t data[]);
+		GFGFileError					AnimationKeyframeData(uint8_t data[], uint32_t animIndex) const;
+		GFGFileError					AllAnimationKeyframeData(uint8_t data[]) const;
 
 		// Data Byte Sizes
 		uint64_t						MeshVertexDataSize(uint32_t meshIndex) const;
@@ -145,6 +424,34 @@ class GFGFileLoader
 		uint64_t						AnimationKeyframeDataSize(uint32_t animIndex) const;
 		uint64_t						AllAnimationKeyframeDataSize()const;
 
+		// Generic Block Access
+		// Block start is relative to the data start (DataLocation)
+		uint64_t						BlockStart(GFGBlockType, uint32_t index) const;
+		uint64_t						BlockSize(GFGBlockType, uint32_t index) const;
+		// For each block of the type, index of the first block that has the same data
+		// (deduplicated files, GFGFileExporter::EnableDeduplication) so that shared data is
+		// loaded once. Unique blocks point to themselves
+		void							SharedBlocks(std::vector<uint32_t>& firstIndices, GFGBlockType) const;
+		// Reads "byteCount" bytes starting from "byteOffset" of the block
+		GFGFileError					BlockDataRange(uint8_t data[], GFGBlockType, uint32_t index,
+													   uint64_t byteOffset, uint64_t byteCount) const;
+		// Reads all of the requested blocks / block ranges with a single reader batch
+		// Requests are sorted by file offset and ranges that are closer than "maxGap"
+		// bytes are merged into a single scatter read (gap is read and discarded)
+		// Nothing is read if any of the blocks is out of file bounds
+		static constexpr uint64_t		DefaultCoalesceGap = 64 * 1024;
+		GFGFileError					BlockData(const GFGBlockRequest requests[], size_t requestCount,
+												  uint64_t maxGap = DefaultCoalesceGap) const;
+		GFGFileError					BlockDataRanges(const GFGBlockRangeRequest requests[], size_t requestCount,
+														uint64_t maxGap = DefaultCoalesceGap) const;
+
+		// Zero-Copy Data Access
+		// Only available when reader maps the file (i.e. GFGFileReaderMMap)
+		// Views point directly to the mapping and valid as long as the reader is alive
+		GFGFileError					MeshVertexDataView(GFGSpan<const uint8_t>& view, uint32_t meshIndex) const;
+		GFGFileError					MeshIndexDataView(GFGSpan<const uint8_t>& view, uint32_t meshIndex) const;
+		GFGFileError					MaterialUniformDataView(GFGSpan<const uint8_t>& view, uint32_t materialIndex) const;
+		GFGFileError					AnimationKeyframeDataView(GFGSpan<const uint8_t>& view, uint32_t animIndex) const;
 
 };
 #endif //__GFG_FILELOADER_H__
\ No newline at end of file
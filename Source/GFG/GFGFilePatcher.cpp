@@ -0,0 +1,199 @@
+#include "GFGFilePatcher.h"
+#include "GFGChecksum.h"
+#include "GFGSpatialIndex.h"
+#include <cassert>
+
+GFGFilePatcher::GFGFilePatcher(const GFGFileLoader& loader,
+							   GFGFileWriterI& writer)
+	: loader(loader)
+	, writer(writer)
+	, loaderError(loader.MaterializeHeader())
+	, header(loader.Header())
+	, headerLocation(loader.HeaderLocation())
+	, dataLocation(loader.DataLocation())
+	, fileSize(loader.FileSize())
+	, hierarchyChanged(false)
+{
+	// Header offsets of the file are kept, serialized header is the same
+	// as the file's header (checksum table is serialized as is)
+	uint64_t headerSize = header.headerSize;
+	header.CalculateHeaderOffsets();
+	GFGFileExporter::SerializeHeader(fileHeader, header, nullptr);
+	if(header.headerSize != headerSize)
+	{
+		// Serialized header size does not match the file's header,
+		// first Commit relocates the header instead of patching in place
+		fileHeader.clear();
+	}
+}
+
+void GFGFilePatcher::SetNodeTransform(uint32_t transformIndex, const GFGTransform& transform)
+{
+	assert(transformIndex < header.transformData.transforms.size());
+	header.transformData.transforms[transformIndex] = transform;
+	hierarchyChanged = true;
+}
+
+void GFGFilePatcher::SetBoneTransform(uint32_t transformIndex, const GFGTransform& transform)
+{
+	assert(transformIndex < header.bonetransformData.transforms.size());
+	header.bonetransformData.transforms[transformIndex] = transform;
+}
+
+void GFGFilePatcher::SetNode(uint32_t nodeIndex, const GFGNode& node)
+{
+	assert(nodeIndex < header.sceneHierarchy.nodes.size());
+	header.sceneHierarchy.nodes[nodeIndex] = node;
+	hierarchyChanged = true;
+}
+
+void GFGFilePatcher::SetMeshMaterial(uint32_t pairIndex, uint32_t materialIndex)
+{
+	assert(pairIndex < header.meshMaterialConnections.pairs.size());
+	assert(materialIndex < header.materials.size());
+	header.meshMaterialConnections.pairs[pairIndex].materialIndex = materialIndex;
+}
+
+GFGFileError GFGFilePatcher::SetUniform(uint32_t materialIndex, uint32_t uniformIndex,
+										GFGSpan<const uint8_t> data)
+{
+	assert(materialIndex < header.materials.size());
+	const GFGMaterialHeader& material = header.materials[materialIndex];
+	assert(uniformIndex < material.uniformList.size());
+	const GFGUniformData& uniform = material.uniformList[uniformIndex];
+	if(data.size() != GFGDataTypeByteSize[static_cast<int>(uniform.dataType)])
+		return GFGFileError::DATA_TYPE_MISMATCH;
+
+	// Whole block is kept for its checksum (uniform blocks are small)
+	auto it = uniformBlocks.find(materialIndex);
+	if(it == uniformBlocks.end())
+	{
+		std::vector<uint8_t> block(static_cast<size_t>(loader.MaterialUniformDataSize(materialIndex)));
+		GFGFileError error = loader.MaterialUniformData(block.data(), materialIndex);
+		if(error != GFGFileError::OK) return error;
+		it = uniformBlocks.emplace(materialIndex, std::move(block)).first;
+	}
+	std::vector<uint8_t>& block = it->second;
+	if(uniform.dataLocation > block.size() || block.size() - uniform.dataLocation < data.size())
+		return GFGFileError::DATA_OFFSET_WRONG;
+
+	std::copy(data.begin(), data.end(), block.begin() + static_cast<size_t>(uniform.dataLocation));
+	dirtyUniforms.insert(materialIndex);
+	return GFGFileError::OK;
+}
+
+uint32_t GFGFilePatcher::AddNodeTransform(const GFGTransform& transform)
+{
+	header.transformData.transforms.push_back(transform);
+	return static_cast<uint32_t>(header.transformData.transforms.size() - 1);
+}
+
+uint32_t GFGFilePatcher::AddNode(const GFGNode& node)
+{
+	header.sceneHierarchy.nodes.push_back(node);
+	hierarchyChanged = true;
+	return static_cast<uint32_t>(header.sceneHierarchy.nodes.size() - 1);
+}
+
+uint32_t GFGFilePatcher::AddMeshMaterialPair(const GFGMeshMatPair& pair)
+{
+	assert(pair.meshIndex < header.meshes.size());
+	assert(pair.materialIndex < header.materials.size());
+	header.meshMaterialConnections.pairs.push_back(pair);
+	return static_cast<uint32_t>(header.meshMaterialConnections.pairs.size() - 1);
+}
+
+GFGFileError GFGFilePatcher::Commit()
+{
+	if(loaderError != GFGFileError::OK) return loaderError;
+
+	// Generated sections
+	if(hierarchyChanged && header.FindExtension(GFGExtensionTag::SPATIAL_INDEX))
+	{
+		GFGSpatialIndex spatialIndex;
+		std::vector<uint8_t> spatialData;
+		spatialIndex.Build(header);
+		spatialIndex.Serialize(spatialData);
+		header.SetExtension(GFGExtensionTag::SPATIAL_INDEX, std::move(spatialData));
+	}
+	GFGChecksumTable checksums;
+	const GFGHeaderExtension* checksumSection = header.FindExtension(GFGExtensionTag::CHECKSUMS);
+	if(checksumSection)
+	{
+		if(!checksums.Load(GFGSpan<const uint8_t>(checksumSection->data),
+						   static_cast<uint32_t>(header.meshes.size()),
+						   static_cast<uint32_t>(header.materials.size()),
+						   static_cast<uint32_t>(header.animations.size())))
+			return GFGFileError::HEADER_CORRUPTED;
+		for(uint32_t materialIndex : dirtyUniforms)
+		{
+			const std::vector<uint8_t>& block = uniformBlocks[materialIndex];
+			checksums.SetBlockChecksum(GFGBlockType::MATERIAL_UNIFORM, materialIndex,
+									   GFGCrc32C(block.data(), block.size()));
+		}
+	}
+
+	// Data offsets are not changed, only the header offsets and the counts
+	std::vector<uint8_t> data;
+	header.CalculateHeaderOffsets();
+	GFGFileExporter::SerializeHeader(data, header, checksumSection ? &checksums : nullptr);
+
+	// Uniforms
+	for(uint32_t materialIndex : dirtyUniforms)
+	{
+		const std::vector<uint8_t>& block = uniformBlocks[materialIndex];
+		writer.WriteAt(block.data(), block.size(),
+					   static_cast<size_t>(dataLocation + header.materials[materialIndex].headerCore.uniformStart));
+	}
+	dirtyUniforms.clear();
+
+	if(data.size() == fileHeader.size())
+	{
+		// Same layout, only the changed bytes are written
+		size_t i = 0;
+		while(i < data.size())
+		{
+			if(data[i] == fileHeader[i])
+			{
+				i++;
+				continue;
+			}
+			size_t end = i + 1;
+			for(size_t j = end; j < data.size() && j - end < MergeGap; j++)
+			{
+				if(data[j] != fileHeader[j]) end = j + 1;
+			}
+			writer.WriteAt(data.data() + i, end - i, static_cast<size_t>(headerLocation + i));
+			i = end;
+		}
+	}
+	else
+	{
+		// Header is relocated to the end of the file,
+		// trailer is written last so that it switches to the new header
+		GFGHeaderTrailer trailer =
+		{
+			fileSize,
+			dataLocation,
+			GFGTrailerFourCC
+		};
+		writer.WriteAt(data.data(), data.size(), static_cast<size_t>(fileSize));
+		writer.WriteAt(reinterpret_cast<const uint8_t*>(&trailer), sizeof(GFGHeaderTrailer),
+					   static_cast<size_t>(fileSize + data.size()));
+		headerLocation = fileSize;
+		fileSize += data.size() + sizeof(GFGHeaderTrailer);
+	}
+	fileHeader = std::move(data);
+	hierarchyChanged = false;
+	return GFGFileError::OK;
+}
+
+const GFGHeader& GFGFilePatcher::Header() const
+{
+	return header;
+}
+
+uint64_t GFGFilePatcher::HeaderLocation() const
+{
+	return headerLocation;
+}
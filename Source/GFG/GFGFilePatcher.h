@@ -0,0 +1,89 @@
+/**
+
+GFGFilePatcher Class
+
+GFGFilePatcher edits the header records (transforms, hierarchy, mesh material
+pairs) and the material uniforms of an existing file without rewriting its
+data blocks.
+
+Edits are done on a copy of the header and written on Commit. If the header
+keeps its size, only the changed bytes of the header are written in place.
+If it grows (i.e. nodes or pairs are added) header is written to the end of
+the file with a GFGHeaderTrailer (same as GFGFileExporter::StartAppend), data
+blocks are never moved. Uniform edits are written to the uniform blocks.
+
+Generated header sections are kept valid on Commit; spatial index is rebuilt
+if the hierarchy or the transforms are changed and checksum table is updated
+with the new header and uniform block checksums.
+
+Loader should be opened on the same file and the writer should open the file
+without truncating it (i.e. GFGFileWriterPOSIX(fileName, false)).
+Loader does not see the edits.
+
+For License refer to:
+https://github.com/yalcinerbora/GFGFileFormat/blob/master/LICENSE
+*/
+
+#ifndef __GFG_FILEPATCHER_H__
+#define __GFG_FILEPATCHER_H__
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "GFGFileExporter.h"
+#include "GFGFileLoader.h"
+
+class GFGFilePatcher
+{
+	private:
+		const GFGFileLoader&						loader;
+		GFGFileWriterI&								writer;
+		GFGFileError								loaderError;		// Header of the loader can not be materialized
+
+		GFGHeader									header;
+		std::vector<uint8_t>						fileHeader;			// Header as it is in the file
+		uint64_t									headerLocation;
+		uint64_t									dataLocation;
+		uint64_t									fileSize;
+
+		bool										hierarchyChanged;
+		std::map<uint32_t, std::vector<uint8_t>>	uniformBlocks;		// Uniform blocks that are edited
+		std::set<uint32_t>							dirtyUniforms;		// Not yet commited
+
+	protected:
+	public:
+		// Changed header bytes that are closer than this are written together
+		static constexpr size_t						MergeGap = 64;
+
+		// Constructors & Destructor
+													GFGFilePatcher(const GFGFileLoader& loader,
+																   GFGFileWriterI& writer);
+													GFGFilePatcher(const GFGFilePatcher&) = delete;
+		GFGFilePatcher&								operator=(const GFGFilePatcher&) = delete;
+													~GFGFilePatcher() = default;
+
+		// Fixed size records
+		void										SetNodeTransform(uint32_t transformIndex, const GFGTransform&);
+		void										SetBoneTransform(uint32_t transformIndex, const GFGTransform&);
+		void										SetNode(uint32_t nodeIndex, const GFGNode&);
+		void										SetMeshMaterial(uint32_t pairIndex, uint32_t materialIndex);
+		// Data size should match the data type of the uniform
+		GFGFileError								SetUniform(uint32_t materialIndex, uint32_t uniformIndex,
+															   GFGSpan<const uint8_t> data);
+
+		// Growing sections (header is relocated on Commit)
+		uint32_t									AddNodeTransform(const GFGTransform&);
+		uint32_t									AddNode(const GFGNode&);
+		uint32_t									AddMeshMaterialPair(const GFGMeshMatPair&);
+
+		// Writes the edits to the file
+		// Returns the loader's error if its header could not be materialized
+		GFGFileError								Commit();
+
+		// Access
+		const GFGHeader&							Header() const;
+		uint64_t									HeaderLocation() const;
+};
+
+#endif //__GFG_FILEPATCHER_H__
@@ -0,0 +1,477 @@
+#include "GFGFileReaderIOUring.h"
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <thread>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+// Single read can not be larger than this (kernel limit is ~2GB)
+static constexpr size_t MaxReadSize = size_t(1) << 30;
+
+static inline uint32_t LoadAcquire(const uint32_t* ptr)
+{
+	return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+static inline void StoreRelease(uint32_t* ptr, uint32_t value)
+{
+	__atomic_store_n(ptr, value, __ATOMIC_RELEASE);
+}
+
+static inline bool IsAligned(size_t value)
+{
+	return (value % GFGFileReaderIOUring::DirectIOAlignment) == 0;
+}
+
+GFGFileReaderIOUring::Operation GFGFileReaderIOUring::AlignedRange(const GFGReadRequest& r)
+{
+	size_t start = r.absLocation - (r.absLocation % DirectIOAlignment);
+	size_t end = r.absLocation + r.readAmount;
+	end = (end + DirectIOAlignment - 1) / DirectIOAlignment * DirectIOAlignment;
+	return Operation{nullptr, end - start, start};
+}
+
+void GFGFileReaderIOUring::Advance(Operation& op, size_t amount)
+{
+	op.absLocation += amount;
+	op.readAmount -= amount;
+	if(!op.vectors)
+	{
+		op.buffer += amount;
+		return;
+	}
+	// Skip fully read vectors, adjust the partially read one
+	while(op.vectorCount > 0 && amount >= op.vectors->iov_len)
+	{
+		amount -= op.vectors->iov_len;
+		op.vectors++;
+		op.vectorCount--;
+	}
+	if(amount > 0)
+	{
+		op.vectors->iov_base = static_cast<uint8_t*>(op.vectors->iov_base) + amount;
+		op.vectors->iov_len -= amount;
+	}
+}
+
+GFGFileReaderIOUring::GFGFileReaderIOUring(const char* fileName,
+										   bool directIO,
+										   uint32_t queueDepth)
+	: fd(-1)
+	, fileSize(0)
+	, filePtr(0)
+	, directIO(false)
+	, ringFd(-1)
+	, ringEntries(0)
+	, sqRing(MAP_FAILED)
+	, sqRingSize(0)
+	, cqRing(MAP_FAILED)
+	, cqRingSize(0)
+	, sqes(nullptr)
+	, sqesSize(0)
+	, sqHead(nullptr)
+	, sqTail(nullptr)
+	, sqMask(nullptr)
+	, sqArray(nullptr)
+	, cqHead(nullptr)
+	, cqTail(nullptr)
+	, cqMask(nullptr)
+	, cqes(nullptr)
+{
+	if(directIO)
+	{
+		// File system may not support it (i.e. tmpfs)
+		fd = open(fileName, O_RDONLY | O_CLOEXEC | O_DIRECT);
+		this->directIO = (fd >= 0);
+	}
+	if(fd < 0) fd = open(fileName, O_RDONLY | O_CLOEXEC);
+	if(fd < 0) return;
+
+	struct stat fileStat;
+	if(fstat(fd, &fileStat) != 0)
+	{
+		close(fd);
+		fd = -1;
+		return;
+	}
+	fileSize = static_cast<size_t>(fileStat.st_size);
+
+	if(!SetupRing(std::max(queueDepth, 1u))) DestroyRing();
+}
+
+GFGFileReaderIOUring::~GFGFileReaderIOUring()
+{
+	DestroyRing();
+	if(fd >= 0) close(fd);
+}
+
+bool GFGFileReaderIOUring::SetupRing(uint32_t queueDepth)
+{
+	io_uring_params params;
+	std::memset(&params, 0, sizeof(io_uring_params));
+	ringFd = static_cast<int>(syscall(__NR_io_uring_setup, queueDepth, &params));
+	if(ringFd < 0) return false;
+
+	ringEntries = params.sq_entries;
+	sqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+	cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+	bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+	if(singleMap)
+	{
+		sqRingSize = std::max(sqRingSize, cqRingSize);
+		cqRingSize = sqRingSize;
+	}
+
+	sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE,
+				  MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+	if(sqRing == MAP_FAILED) return false;
+	if(singleMap)
+		cqRing = sqRing;
+	else
+	{
+		cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE,
+					  MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+		if(cqRing == MAP_FAILED) return false;
+	}
+
+	sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+	void* sqePtr = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+						MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+	if(sqePtr == MAP_FAILED) return false;
+	sqes = static_cast<io_uring_sqe*>(sqePtr);
+
+	uint8_t* sq = static_cast<uint8_t*>(sqRing);
+	sqHead = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+	sqTail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+	sqMask = reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+	sqArray = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+
+	uint8_t* cq = static_cast<uint8_t*>(cqRing);
+	cqHead = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+	cqTail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+	cqMask = reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+	cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+	return true;
+}
+
+void GFGFileReaderIOUring::DestroyRing()
+{
+	if(sqes) munmap(sqes, sqesSize);
+	if(cqRing != MAP_FAILED && cqRing != sqRing) munmap(cqRing, cqRingSize);
+	if(sqRing != MAP_FAILED) munmap(sqRing, sqRingSize);
+	if(ringFd >= 0) close(ringFd);
+	sqes = nullptr;
+	cqRing = MAP_FAILED;
+	sqRing = MAP_FAILED;
+	ringFd = -1;
+	ringEntries = 0;
+	sqHead = nullptr;
+	sqTail = nullptr;
+	sqMask = nullptr;
+	sqArray = nullptr;
+	cqHead = nullptr;
+	cqTail = nullptr;
+	cqMask = nullptr;
+	cqes = nullptr;
+}
+
+void GFGFileReaderIOUring::ExecuteRing(std::vector<Operation>& ops)
+{
+	std::unique_lock<std::mutex> lock(ringMutex);
+
+	// Ring may be destroyed by an another batch while waiting for the lock
+	if(ringFd < 0)
+	{
+		lock.unlock();
+		ExecuteSync(ops);
+		return;
+	}
+
+	// Short reads are re-submitted with the remaining portion
+	std::vector<uint32_t> retry;
+	size_t next = 0;
+	uint32_t inFlight = 0;
+	auto Reap = [&]()
+	{
+		uint32_t cHead = *cqHead;
+		uint32_t cTail = LoadAcquire(cqTail);
+		for(; cHead != cTail; cHead++)
+		{
+			const io_uring_cqe& cqe = cqes[cHead & *cqMask];
+			uint32_t opIndex = static_cast<uint32_t>(cqe.user_data);
+			Operation& op = ops[opIndex];
+			inFlight--;
+
+			if(cqe.res == -EINTR || cqe.res == -EAGAIN)
+				retry.push_back(opIndex);
+			else if(cqe.res <= 0)
+				op.readAmount = 0;	// EOF or error, nothing more can be read
+			else
+			{
+				Advance(op, static_cast<size_t>(cqe.res));
+				if(op.readAmount > 0) retry.push_back(opIndex);
+			}
+		}
+		StoreRelease(cqHead, cHead);
+	};
+	while(next < ops.size() || !retry.empty() || inFlight > 0)
+	{
+		// Fill the submission queue
+		uint32_t tail = *sqTail;
+		uint32_t head = LoadAcquire(sqHead);
+		while(inFlight < ringEntries && (tail - head) < ringEntries)
+		{
+			uint32_t opIndex;
+			if(!retry.empty())
+			{
+				opIndex = retry.back();
+				retry.pop_back();
+			}
+			else if(next < ops.size())
+				opIndex = static_cast<uint32_t>(next++);
+			else break;
+
+			const Operation& op = ops[opIndex];
+			uint32_t slot = tail & *sqMask;
+			io_uring_sqe& sqe = sqes[slot];
+			std::memset(&sqe, 0, sizeof(io_uring_sqe));
+			sqe.fd = fd;
+			sqe.off = op.absLocation;
+			if(op.vectors)
+			{
+				sqe.opcode = IORING_OP_READV;
+				sqe.addr = reinterpret_cast<uint64_t>(op.vectors);
+				sqe.len = static_cast<uint32_t>(op.vectorCount);
+			}
+			else
+			{
+				sqe.opcode = IORING_OP_READ;
+				sqe.addr = reinterpret_cast<uint64_t>(op.buffer);
+				sqe.len = static_cast<uint32_t>(std::min(op.readAmount, MaxReadSize));
+			}
+			sqe.user_data = opIndex;
+			sqArray[slot] = slot;
+			tail++;
+			inFlight++;
+		}
+		StoreRelease(sqTail, tail);
+
+		// Submit whatever kernel did not consume yet and wait for at least one
+		uint32_t toSubmit = tail - LoadAcquire(sqHead);
+		int result = static_cast<int>(syscall(__NR_io_uring_enter, ringFd, toSubmit, 1,
+											  IORING_ENTER_GETEVENTS, nullptr, 0));
+		if(result < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+		{
+			// Ring is unusable. Entries that are not consumed by the kernel are
+			// taken back, consumed ones may still write to the buffers so they
+			// are reaped before the ring is destroyed
+			uint32_t unconsumed = tail - LoadAcquire(sqHead);
+			StoreRelease(sqTail, tail - unconsumed);
+			inFlight -= unconsumed;
+			for(Reap(); inFlight > 0; Reap())
+			{
+				if(syscall(__NR_io_uring_enter, ringFd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) < 0)
+					std::this_thread::yield();
+			}
+
+			// Finish the remaining reads synchronously
+			DestroyRing();
+			lock.unlock();
+			ExecuteSync(ops);
+			return;
+		}
+		Reap();
+	}
+}
+
+void GFGFileReaderIOUring::ExecuteSync(std::vector<Operation>& ops)
+{
+	for(Operation& op : ops)
+	{
+		while(op.readAmount > 0)
+		{
+			ssize_t result = (op.vectors)
+				? preadv(fd, op.vectors, static_cast<int>(op.vectorCount),
+						 static_cast<off_t>(op.absLocation))
+				: pread(fd, op.buffer, std::min(op.readAmount, MaxReadSize),
+						static_cast<off_t>(op.absLocation));
+			if(result < 0 && errno == EINTR) continue;
+			if(result <= 0) break;
+			Advance(op, static_cast<size_t>(result));
+		}
+		op.readAmount = 0;
+	}
+}
+
+bool GFGFileReaderIOUring::IsOpen() const
+{
+	return fd >= 0;
+}
+
+bool GFGFileReaderIOUring::IsAsync() const
+{
+	return ringFd >= 0;
+}
+
+bool GFGFileReaderIOUring::IsDirectIO() const
+{
+	return directIO;
+}
+
+void GFGFileReaderIOUring::Read(uint8_t buffer[], size_t readAmount)
+{
+	ReadAt(buffer, readAmount, filePtr);
+	filePtr += readAmount;
+}
+
+void GFGFileReaderIOUring::MovePtrAbs(size_t absLocation)
+{
+	filePtr = absLocation;
+}
+
+void GFGFileReaderIOUring::MovePtrRelative(int64_t relLocation, GFGDirection dir)
+{
+	switch(dir)
+	{
+		case GFGDirection::FROM_START:	filePtr = static_cast<size_t>(relLocation); break;
+		case GFGDirection::FROM_CURRENT:	filePtr = static_cast<size_t>(filePtr + relLocation); break;
+		case GFGDirection::FROM_END:		filePtr = static_cast<size_t>(fileSize + relLocation); break;
+	}
+}
+
+size_t GFGFileReaderIOUring::GetFileSize()
+{
+	return fileSize;
+}
+
+void GFGFileReaderIOUring::ReadAt(uint8_t buffer[], size_t readAmount, size_t absLocation)
+{
+	GFGReadRequest request = {buffer, readAmount, absLocation};
+	ReadBatch(&request, 1);
+}
+
+bool GFGFileReaderIOUring::IsReadAtThreadSafe() const
+{
+	return true;
+}
+
+void GFGFileReaderIOUring::ReadBatch(const GFGReadRequest requests[], size_t requestCount)
+{
+	struct FreeDeleter { void operator()(uint8_t* p) const { FreeAligned(p); } };
+	static constexpr size_t NoBounce = std::numeric_limits<size_t>::max();
+
+	// Unaligned direct reads go through a single bounce allocation
+	std::vector<size_t> bounceOffsets(requestCount, NoBounce);
+	size_t bounceSize = 0;
+	for(size_t i = 0; directIO && i < requestCount; i++)
+	{
+		const GFGReadRequest& r = requests[i];
+		if(IsAligned(reinterpret_cast<size_t>(r.buffer)) &&
+		   IsAligned(r.absLocation) && IsAligned(r.readAmount))
+			continue;
+		bounceOffsets[i] = bounceSize;
+		bounceSize += AlignedRange(r).readAmount;
+	}
+	std::unique_ptr<uint8_t, FreeDeleter> bounce;
+	if(bounceSize > 0) bounce.reset(AllocateAligned(bounceSize));
+
+	std::vector<Operation> ops;
+	ops.reserve(requestCount);
+	for(size_t i = 0; i < requestCount; i++)
+	{
+		const GFGReadRequest& r = requests[i];
+		if(bounceOffsets[i] == NoBounce)
+			ops.push_back(Operation{r.buffer, r.readAmount, r.absLocation});
+		else
+		{
+			Operation op = AlignedRange(r);
+			op.buffer = bounce.get() + bounceOffsets[i];
+			ops.push_back(op);
+		}
+	}
+
+	// Ring state is checked under the ring lock
+	ExecuteRing(ops);
+
+	for(size_t i = 0; i < requestCount; i++)
+	{
+		if(bounceOffsets[i] == NoBounce) continue;
+		const GFGReadRequest& r = requests[i];
+		size_t skip = r.absLocation % DirectIOAlignment;
+		std::memcpy(r.buffer, bounce.get() + bounceOffsets[i] + skip, r.readAmount);
+	}
+}
+
+void GFGFileReaderIOUring::ReadVectoredBatch(const GFGVectoredReadRequest requests[],
+											 size_t requestCount)
+{
+	// Each scatter read is a single vectored read (at most IOV_MAX vectors each)
+	// Direct reads that are not aligned are split and go through the bounce buffer
+	size_t vectorCount = 0;
+	for(size_t i = 0; i < requestCount; i++)
+		vectorCount += requests[i].vectorCount;
+	std::vector<iovec> vectors;
+	vectors.reserve(vectorCount);
+	std::vector<Operation> ops;
+	std::vector<GFGVectoredReadRequest> unaligned;
+	for(size_t i = 0; i < requestCount; i++)
+	{
+		const GFGVectoredReadRequest& r = requests[i];
+		bool aligned = !directIO || IsAligned(r.absLocation);
+		for(size_t j = 0; aligned && j < r.vectorCount; j++)
+		{
+			aligned = IsAligned(reinterpret_cast<size_t>(r.vectors[j].buffer)) &&
+					  IsAligned(r.vectors[j].size);
+		}
+		if(!aligned)
+		{
+			unaligned.push_back(r);
+			continue;
+		}
+
+		size_t location = r.absLocation;
+		for(size_t j = 0; j < r.vectorCount; j += IOV_MAX)
+		{
+			size_t count = std::min<size_t>(r.vectorCount - j, IOV_MAX);
+			Operation op = {nullptr, 0, location, vectors.data() + vectors.size(), count};
+			for(size_t k = j; k < j + count; k++)
+			{
+				vectors.push_back(iovec{r.vectors[k].buffer, r.vectors[k].size});
+				op.readAmount += r.vectors[k].size;
+			}
+			location += op.readAmount;
+			if(op.readAmount > 0) ops.push_back(op);
+		}
+	}
+
+	// Ring state is checked under the ring lock
+	if(!ops.empty()) ExecuteRing(ops);
+	if(!unaligned.empty())
+		GFGFileReaderI::ReadVectoredBatch(unaligned.data(), unaligned.size());
+}
+
+uint8_t* GFGFileReaderIOUring::AllocateAligned(size_t size)
+{
+	size = (size + DirectIOAlignment - 1) / DirectIOAlignment * DirectIOAlignment;
+	void* ptr = nullptr;
+	if(posix_memalign(&ptr, DirectIOAlignment, std::max(size, DirectIOAlignment)) != 0)
+		return nullptr;
+	return static_cast<uint8_t*>(ptr);
+}
+
+void GFGFileReaderIOUring::FreeAligned(uint8_t* ptr)
+{
+	std::free(ptr);
+}
\ No newline at end of file
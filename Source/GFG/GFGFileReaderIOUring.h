@@ -0,0 +1,119 @@
+/**
+
+GFGFileReaderIOUring Class
+
+io_uring based implementation of the GFGFileReaderI interface (Linux only).
+
+ReadBatch submits all of the reads of a batch to the kernel at once
+and reaps the completions as they arrive, so that a deep queue NVMe drive
+can serve them in parallel. Loader issues one batch per
+GFGFileLoader::BlockData call. Scatter reads (ReadVectoredBatch) are
+submitted as single vectored reads. Ring is shared and guarded by a mutex,
+ReadAt is a single request batch.
+
+Optionally file can be opened with O_DIRECT (bypasses the page cache,
+usefull for multi-gigabyte files that are read once). Direct reads require
+buffer address, file location and size to be aligned to "DirectIOAlignment",
+buffers that are allocated with AllocateAligned and blocks that are aligned
+are read directly. Others are read through an aligned bounce buffer.
+If file system does not support O_DIRECT file is opened normally.
+
+If kernel does not support io_uring (or it is disabled) reader falls back
+to "pread".
+
+For License refer to:
+https://github.com/yalcinerbora/GFGFileFormat/blob/master/LICENSE
+*/
+
+#ifndef __GFG_FILEREADERIOURING_H__
+#define __GFG_FILEREADERIOURING_H__
+
+#include <mutex>
+#include <vector>
+#include "GFGFileLoader.h"
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+struct iovec;
+
+class GFGFileReaderIOUring : public GFGFileReaderI
+{
+	public:
+		static constexpr size_t		DirectIOAlignment = 4096;
+		static constexpr uint32_t	DefaultQueueDepth = 64;
+
+	private:
+		struct Operation
+		{
+			uint8_t*				buffer;
+			size_t					readAmount;
+			size_t					absLocation;
+			// Scatter read if not nullptr (buffer is not used)
+			iovec*					vectors = nullptr;
+			size_t					vectorCount = 0;
+		};
+
+		int							fd;
+		size_t						fileSize;
+		size_t						filePtr;
+		bool						directIO;
+
+		// Ring
+		int							ringFd;
+		uint32_t					ringEntries;
+		void*						sqRing;
+		size_t						sqRingSize;
+		void*						cqRing;
+		size_t						cqRingSize;
+		io_uring_sqe*				sqes;
+		size_t						sqesSize;
+		uint32_t*					sqHead;
+		uint32_t*					sqTail;
+		uint32_t*					sqMask;
+		uint32_t*					sqArray;
+		uint32_t*					cqHead;
+		uint32_t*					cqTail;
+		uint32_t*					cqMask;
+		io_uring_cqe*				cqes;
+		std::mutex					ringMutex;
+
+		static Operation			AlignedRange(const GFGReadRequest&);
+		static void					Advance(Operation&, size_t amount);
+		bool						SetupRing(uint32_t queueDepth);
+		void						DestroyRing();
+		// Falls back to ExecuteSync if the ring is not available
+		void						ExecuteRing(std::vector<Operation>&);
+		void						ExecuteSync(std::vector<Operation>&);
+
+	protected:
+	public:
+		// Constructors & Destructor
+									GFGFileReaderIOUring(const char* fileName,
+														 bool directIO = false,
+														 uint32_t queueDepth = DefaultQueueDepth);
+									GFGFileReaderIOUring(const GFGFileReaderIOUring&) = delete;
+		GFGFileReaderIOUring&		operator=(const GFGFileReaderIOUring&) = delete;
+									~GFGFileReaderIOUring();
+
+		bool						IsOpen() const;
+		// False if io_uring is not available (reads are done with pread)
+		bool						IsAsync() const;
+		// False if direct io is not requested or not supported
+		bool						IsDirectIO() const;
+
+		void						Read(uint8_t buffer[], size_t readAmount) override;
+		void						MovePtrAbs(size_t absLocation) override;
+		void						MovePtrRelative(int64_t relLocation, GFGDirection dir) override;
+		size_t						GetFileSize() override;
+
+		void						ReadAt(uint8_t buffer[], size_t readAmount, size_t absLocation) override;
+		bool						IsReadAtThreadSafe() const override;
+		void						ReadBatch(const GFGReadRequest requests[], size_t requestCount) override;
+		void						ReadVectoredBatch(const GFGVectoredReadRequest requests[],
+													  size_t requestCount) override;
+
+		// Buffers suitable for direct reads (size is rounded up to the alignment)
+		static uint8_t*				AllocateAligned(size_t size);
+		static void					FreeAligned(uint8_t*);
+};
+#endif //__GFG_FILEREADERIOURING_H__
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "GFGFileReaderMMap.h"
+#include <cassert>
+#include <cstring>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+GFGFileReaderMMap::GFGFileReaderMMap(const char* fileName)
+	: mapping(nullptr)
+	, fileSize(0)
+	, filePtr(0)
+{
+	int fd = open(fileName, O_RDONLY | O_CLOEXEC);
+	if(fd < 0) return;
+
+	struct stat fileStat;
+	if(fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+	{
+		size_t size = static_cast<size_t>(fileStat.st_size);
+		void* ptr = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+		if(ptr != MAP_FAILED)
+		{
+			// Loader jumps around header then reads large data blocks,
+			// let the kernel do aggresive read-ahead
+			madvise(ptr, size, MADV_WILLNEED);
+			mapping = static_cast<const uint8_t*>(ptr);
+			fileSize = size;
+		}
+	}
+	// Mapping holds its own reference to the file
+	close(fd);
+}
+
+GFGFileReaderMMap::~GFGFileReaderMMap()
+{
+	if(mapping) munmap(const_cast<uint8_t*>(mapping), fileSize);
+}
+
+bool GFGFileReaderMMap::IsOpen() const
+{
+	return mapping != nullptr;
+}
+
+void GFGFileReaderMMap::Read(uint8_t buffer[], size_t readAmount)
+{
+	assert(filePtr + readAmount <= fileSize);
+	size_t amount = std::min(readAmount, fileSize - std::min(filePtr, fileSize));
+	std::memcpy(buffer, mapping + filePtr, amount);
+	filePtr += amount;
+}
+
+void GFGFileReaderMMap::MovePtrAbs(size_t absLocation)
+{
+	filePtr = absLocation;
+}
+
+void GFGFileReaderMMap::MovePtrRelative(int64_t relLocation, GFGDirection dir)
+{
+	switch(dir)
+	{
+		case GFGDirection::FROM_START:
+			filePtr = static_cast<size_t>(relLocation);
+			break;
+		case GFGDirection::FROM_CURRENT:
+			filePtr = static_cast<size_t>(static_cast<int64_t>(filePtr) + relLocation);
+			break;
+		case GFGDirection::FROM_END:
+			filePtr = static_cast<size_t>(static_cast<int64_t>(fileSize) + relLocation);
+			break;
+	}
+}
+
+size_t GFGFileReaderMMap::GetFileSize()
+{
+	return fileSize;
+}
+
+void GFGFileReaderMMap::ReadAt(uint8_t buffer[], size_t readAmount, size_t absLocation)
+{
+	assert(absLocation + readAmount <= fileSize);
+	size_t amount = std::min(readAmount, fileSize - std::min(absLocation, fileSize));
+	std::memcpy(buffer, mapping + absLocation, amount);
+}
+
+bool GFGFileReaderMMap::IsReadAtThreadSafe() const
+{
+	return true;
+}
+
+const uint8_t* GFGFileReaderMMap::MappedData()
+{
+	return mapping;
+}
\ No newline at end of file
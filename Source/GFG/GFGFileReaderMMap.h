@@ -0,0 +1,51 @@
+/**
+
+GFGFileReaderMMap Class
+
+Memory mapped implementation of the GFGFileReaderI interface (POSIX only).
+
+Whole file is mapped read-only and shared, so pages come directly from
+the page cache (and shared between processes that open the same file).
+Since file is in the address space, GFGFileLoader can return views
+(GFGSpan) of the data blocks instead of copying them to user buffers.
+
+Returned views are valid as long as the reader is alive.
+
+For License refer to:
+https://github.com/yalcinerbora/GFGFileFormat/blob/master/LICENSE
+*/
+
+#ifndef __GFG_FILEREADERMMAP_H__
+#define __GFG_FILEREADERMMAP_H__
+
+#include "GFGFileLoader.h"
+
+class GFGFileReaderMMap : public GFGFileReaderI
+{
+	private:
+		const uint8_t*			mapping;
+		size_t					fileSize;
+		size_t					filePtr;
+
+	protected:
+	public:
+		// Constructors & Destructor
+								GFGFileReaderMMap(const char* fileName);
+								GFGFileReaderMMap(const GFGFileReaderMMap&) = delete;
+		GFGFileReaderMMap&		operator=(const GFGFileReaderMMap&) = delete;
+								~GFGFileReaderMMap();
+
+		// Mapping may fail (file does not exist, empty file etc.)
+		bool					IsOpen() const;
+
+		void					Read(uint8_t buffer[], size_t readAmount) override;
+		void					MovePtrAbs(size_t absLocation) override;
+		void					MovePtrRelative(int64_t relLocation, GFGDirection dir) override;
+		size_t					GetFileSize() override;
+
+		void					ReadAt(uint8_t buffer[], size_t readAmount, size_t absLocation) override;
+		bool					IsReadAtThreadSafe() const override;
+
+		const uint8_t*			MappedData() override;
+};
+#endif //__GFG_FILEREADERMMAP_H__
\ No newline at end of file
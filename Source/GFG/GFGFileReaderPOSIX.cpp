@@ -0,0 +1,127 @@
+#include "GFGFileReaderPOSIX.h"
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <climits>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include <sys/stat.h>
+
+GFGFileReaderPOSIX::GFGFileReaderPOSIX(const char* fileName)
+	: fd(-1)
+	, fileSize(0)
+{
+	fd = open(fileName, O_RDONLY | O_CLOEXEC);
+	if(fd < 0) return;
+
+	struct stat fileStat;
+	if(fstat(fd, &fileStat) != 0)
+	{
+		close(fd);
+		fd = -1;
+		return;
+	}
+	fileSize = static_cast<size_t>(fileStat.st_size);
+}
+
+GFGFileReaderPOSIX::~GFGFileReaderPOSIX()
+{
+	if(fd >= 0) close(fd);
+}
+
+bool GFGFileReaderPOSIX::IsOpen() const
+{
+	return fd >= 0;
+}
+
+void GFGFileReaderPOSIX::Read(uint8_t buffer[], size_t readAmount)
+{
+	while(readAmount > 0)
+	{
+		ssize_t result = read(fd, buffer, readAmount);
+		if(result < 0 && errno == EINTR) continue;
+		if(result <= 0) break;
+		buffer += result;
+		readAmount -= static_cast<size_t>(result);
+	}
+}
+
+void GFGFileReaderPOSIX::MovePtrAbs(size_t absLocation)
+{
+	lseek(fd, static_cast<off_t>(absLocation), SEEK_SET);
+}
+
+void GFGFileReaderPOSIX::MovePtrRelative(int64_t relLocation, GFGDirection dir)
+{
+	static const int lookup[] =
+	{
+		SEEK_SET,
+		SEEK_CUR,
+		SEEK_END
+	};
+	lseek(fd, static_cast<off_t>(relLocation), lookup[static_cast<int>(dir)]);
+}
+
+size_t GFGFileReaderPOSIX::GetFileSize()
+{
+	return fileSize;
+}
+
+void GFGFileReaderPOSIX::ReadAt(uint8_t buffer[], size_t readAmount, size_t absLocation)
+{
+	// pread may return less than requested (large reads, signals)
+	while(readAmount > 0)
+	{
+		ssize_t result = pread(fd, buffer, readAmount, static_cast<off_t>(absLocation));
+		if(result < 0 && errno == EINTR) continue;
+		if(result <= 0) break;
+		buffer += result;
+		absLocation += static_cast<size_t>(result);
+		readAmount -= static_cast<size_t>(result);
+	}
+}
+
+bool GFGFileReaderPOSIX::IsReadAtThreadSafe() const
+{
+	return true;
+}
+
+void GFGFileReaderPOSIX::ReadVectoredBatch(const GFGVectoredReadRequest requests[], size_t requestCount)
+{
+	std::vector<iovec> vectors;
+	for(size_t i = 0; i < requestCount; i++)
+	{
+		const GFGVectoredReadRequest& r = requests[i];
+		vectors.resize(r.vectorCount);
+		for(size_t j = 0; j < r.vectorCount; j++)
+			vectors[j] = iovec{r.vectors[j].buffer, r.vectors[j].size};
+
+		// preadv can take at most IOV_MAX vectors and may return less than requested
+		size_t location = r.absLocation;
+		size_t first = 0;
+		while(first < vectors.size())
+		{
+			int count = static_cast<int>(std::min<size_t>(vectors.size() - first, IOV_MAX));
+			ssize_t result = preadv(fd, vectors.data() + first, count, static_cast<off_t>(location));
+			if(result < 0 && errno == EINTR) continue;
+			if(result <= 0) break;
+			location += static_cast<size_t>(result);
+
+			// Skip fully read vectors, adjust the partially read one
+			size_t amount = static_cast<size_t>(result);
+			while(first < vectors.size() && amount >= vectors[first].iov_len)
+			{
+				amount -= vectors[first].iov_len;
+				first++;
+			}
+			if(amount > 0)
+			{
+				vectors[first].iov_base = static_cast<uint8_t*>(vectors[first].iov_base) + amount;
+				vectors[first].iov_len -= amount;
+			}
+		}
+	}
+}
\ No newline at end of file
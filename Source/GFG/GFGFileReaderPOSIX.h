@@ -0,0 +1,47 @@
+/**
+
+GFGFileReaderPOSIX Class
+
+File descriptor based implementation of the GFGFileReaderI interface (POSIX only).
+
+ReadAt uses "pread" which does not touch the shared file pointer, thus
+single reader (and a single GFGFileLoader) can be used from
+multiple threads concurrently. File size is fetched once on open.
+Scatter reads (coalesced block reads of the loader) use "preadv".
+
+For License refer to:
+https://github.com/yalcinerbora/GFGFileFormat/blob/master/LICENSE
+*/
+
+#ifndef __GFG_FILEREADERPOSIX_H__
+#define __GFG_FILEREADERPOSIX_H__
+
+#include "GFGFileLoader.h"
+
+class GFGFileReaderPOSIX : public GFGFileReaderI
+{
+	private:
+		int						fd;
+		size_t					fileSize;
+
+	protected:
+	public:
+		// Constructors & Destructor
+								GFGFileReaderPOSIX(const char* fileName);
+								GFGFileReaderPOSIX(const GFGFileReaderPOSIX&) = delete;
+		GFGFileReaderPOSIX&		operator=(const GFGFileReaderPOSIX&) = delete;
+								~GFGFileReaderPOSIX();
+
+		bool					IsOpen() const;
+
+		void					Read(uint8_t buffer[], size_t readAmount) override;
+		void					MovePtrAbs(size_t absLocation) override;
+		void					MovePtrRelative(int64_t relLocation, GFGDirection dir) override;
+		size_t					GetFileSize() override;
+
+		void					ReadAt(uint8_t buffer[], size_t readAmount, size_t absLocation) override;
+		bool					IsReadAtThreadSafe() const override;
+		void					ReadVectoredBatch(const GFGVectoredReadRequest requests[],
+												  size_t requestCount) override;
+};
+#endif //__GFG_FILEREADERPOSIX_H__
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "GFGFileWriterMMap.h"
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+GFGFileWriterMMap::GFGFileWriterMMap(const char* fileName, size_t size)
+	: mapping(nullptr)
+	, fileSize(0)
+	, filePtr(0)
+{
+	if(size == 0) return;
+	int fd = open(fileName, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if(fd < 0) return;
+
+	// Allocate the blocks up front, file systems that do not support
+	// allocation get a sparse file instead
+	int error = posix_fallocate(fd, 0, static_cast<off_t>(size));
+	bool allocated = (error == 0);
+	if(error == EINVAL || error == EOPNOTSUPP)
+		allocated = (ftruncate(fd, static_cast<off_t>(size)) == 0);
+
+	if(allocated)
+	{
+		void* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if(ptr != MAP_FAILED)
+		{
+			// Exporter writes the file front to back
+			madvise(ptr, size, MADV_SEQUENTIAL);
+			mapping = static_cast<uint8_t*>(ptr);
+			fileSize = size;
+		}
+	}
+	// Mapping holds its own reference to the file
+	close(fd);
+}
+
+GFGFileWriterMMap::~GFGFileWriterMMap()
+{
+	if(mapping) munmap(mapping, fileSize);
+}
+
+bool GFGFileWriterMMap::IsOpen() const
+{
+	return mapping != nullptr;
+}
+
+void GFGFileWriterMMap::Write(const uint8_t buffer[], size_t writeAmount)
+{
+	assert(filePtr + writeAmount <= fileSize);
+	size_t amount = std::min(writeAmount, fileSize - std::min(filePtr, fileSize));
+	std::memcpy(mapping + filePtr, buffer, amount);
+	filePtr += amount;
+}
+
+bool GFGFileWriterMMap::MovePtrAbs(size_t absLocation)
+{
+	filePtr = absLocation;
+	return absLocation <= fileSize;
+}
+
+bool GFGFileWriterMMap::WriteAt(const uint8_t buffer[], size_t writeAmount, size_t absLocation)
+{
+	assert(absLocation + writeAmount <= fileSize);
+	size_t amount = std::min(writeAmount, fileSize - std::min(absLocation, fileSize));
+	std::memcpy(mapping + absLocation, buffer, amount);
+	return amount == writeAmount;
+}
+
+bool GFGFileWriterMMap::IsWriteAtThreadSafe() const
+{
+	return true;
+}
+
+uint8_t* GFGFileWriterMMap::MappedData()
+{
+	return mapping;
+}
+
+size_t GFGFileWriterMMap::FileSize() const
+{
+	return fileSize;
+}
+
+bool GFGFileWriterMMap::Sync()
+{
+	return mapping && msync(mapping, fileSize, MS_SYNC) == 0;
+}
@@ -0,0 +1,54 @@
+/**
+
+GFGFileWriterMMap Class
+
+Memory mapped implementation of the GFGFileWriterI interface (POSIX only).
+
+Final file size should be known on open (GFGFileExporter::CalculateFileSize).
+File is preallocated with that size (to prevent fragmentation of large files)
+and mapped writable and shared. Writes are copies to the mapping thus
+WriteAt can be called from multiple threads concurrently.
+
+Mapping is also given to the user (MappedData) so that data blocks can be
+produced directly on the file (i.e. reserved blocks of the GFGFileExporter)
+instead of a staging buffer. Mapping is valid as long as the writer is alive.
+
+For License refer to:
+https://github.com/yalcinerbora/GFGFileFormat/blob/master/LICENSE
+*/
+
+#ifndef __GFG_FILEWRITERMMAP_H__
+#define __GFG_FILEWRITERMMAP_H__
+
+#include "GFGFileExporter.h"
+
+class GFGFileWriterMMap : public GFGFileWriterI
+{
+	private:
+		uint8_t*				mapping;
+		size_t					fileSize;
+		size_t					filePtr;
+
+	protected:
+	public:
+		// Constructors & Destructor
+								GFGFileWriterMMap(const char* fileName, size_t fileSize);
+								GFGFileWriterMMap(const GFGFileWriterMMap&) = delete;
+		GFGFileWriterMMap&		operator=(const GFGFileWriterMMap&) = delete;
+								~GFGFileWriterMMap();
+
+		// Allocation or mapping may fail (not enough space, empty file etc.)
+		bool					IsOpen() const;
+
+		void					Write(const uint8_t buffer[], size_t writeAmount) override;
+		bool					MovePtrAbs(size_t absLocation) override;
+
+		bool					WriteAt(const uint8_t buffer[], size_t writeAmount, size_t absLocation) override;
+		bool					IsWriteAtThreadSafe() const override;
+
+		uint8_t*				MappedData();
+		size_t					FileSize() const;
+		// Flushes the mapping to the file (unmapping also writes back, this waits for it)
+		bool					Sync();
+};
+#endif //__GFG_FILEWRITERMMAP_H__
@@ -0,0 +1,93 @@
+#include "GFGFileWriterPOSIX.h"
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+GFGFileWriterPOSIX::GFGFileWriterPOSIX(const char* fileName, bool truncate)
+	: fd(-1)
+{
+	fd = open(fileName, O_WRONLY | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : 0), 0644);
+}
+
+GFGFileWriterPOSIX::~GFGFileWriterPOSIX()
+{
+	if(fd >= 0) close(fd);
+}
+
+bool GFGFileWriterPOSIX::IsOpen() const
+{
+	return fd >= 0;
+}
+
+void GFGFileWriterPOSIX::Write(const uint8_t buffer[], size_t writeAmount)
+{
+	while(writeAmount > 0)
+	{
+		ssize_t result = write(fd, buffer, writeAmount);
+		if(result < 0 && errno == EINTR) continue;
+		if(result <= 0) break;
+		buffer += result;
+		writeAmount -= static_cast<size_t>(result);
+	}
+}
+
+bool GFGFileWriterPOSIX::MovePtrAbs(size_t absLocation)
+{
+	return lseek(fd, static_cast<off_t>(absLocation), SEEK_SET) >= 0;
+}
+
+bool GFGFileWriterPOSIX::WriteAt(const uint8_t buffer[], size_t writeAmount, size_t absLocation)
+{
+	// pwrite may write less than requested (large writes, signals)
+	while(writeAmount > 0)
+	{
+		ssize_t result = pwrite(fd, buffer, writeAmount, static_cast<off_t>(absLocation));
+		if(result < 0 && errno == EINTR) continue;
+		if(result <= 0) return false;
+		buffer += result;
+		absLocation += static_cast<size_t>(result);
+		writeAmount -= static_cast<size_t>(result);
+	}
+	return true;
+}
+
+bool GFGFileWriterPOSIX::IsWriteAtThreadSafe() const
+{
+	return true;
+}
+
+bool GFGFileWriterPOSIX::WriteVectored(const GFGWriteVec vectors[], size_t vectorCount)
+{
+	std::vector<iovec> iovecs(vectorCount);
+	for(size_t i = 0; i < vectorCount; i++)
+		iovecs[i] = iovec{const_cast<uint8_t*>(vectors[i].buffer), vectors[i].size};
+
+	// writev can take at most IOV_MAX vectors and may write less than requested
+	size_t first = 0;
+	while(first < iovecs.size())
+	{
+		int count = static_cast<int>(std::min<size_t>(iovecs.size() - first, IOV_MAX));
+		ssize_t result = writev(fd, iovecs.data() + first, count);
+		if(result < 0 && errno == EINTR) continue;
+		if(result <= 0) return false;
+
+		// Skip fully written vectors, adjust the partially written one
+		size_t amount = static_cast<size_t>(result);
+		while(first < iovecs.size() && amount >= iovecs[first].iov_len)
+		{
+			amount -= iovecs[first].iov_len;
+			first++;
+		}
+		if(amount > 0)
+		{
+			iovecs[first].iov_base = static_cast<uint8_t*>(iovecs[first].iov_base) + amount;
+			iovecs[first].iov_len -= amount;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,44 @@
+/**
+
+GFGFileWriterPOSIX Class
+
+File descriptor based implementation of the GFGFileWriterI interface (POSIX only).
+
+WriteAt uses "pwrite" which does not touch the shared file pointer, thus
+single writer can be used from multiple threads concurrently
+(i.e. parallel GFGFileExporter::Write). File is created (or truncated) on open,
+existing files can be opened without truncation (i.e. GFGFileExporter::StartAppend).
+Gather writes (header and data blocks of GFGFileExporter::Write) use "writev".
+
+For License refer to:
+https://github.com/yalcinerbora/GFGFileFormat/blob/master/LICENSE
+*/
+
+#ifndef __GFG_FILEWRITERPOSIX_H__
+#define __GFG_FILEWRITERPOSIX_H__
+
+#include "GFGFileExporter.h"
+
+class GFGFileWriterPOSIX : public GFGFileWriterI
+{
+	private:
+		int						fd;
+
+	protected:
+	public:
+		// Constructors & Destructor
+								GFGFileWriterPOSIX(const char* fileName, bool truncate = true);
+								GFGFileWriterPOSIX(const GFGFileWriterPOSIX&) = delete;
+		GFGFileWriterPOSIX&		operator=(const GFGFileWriterPOSIX&) = delete;
+								~GFGFileWriterPOSIX();
+
+		bool					IsOpen() const;
+
+		void					Write(const uint8_t buffer[], size_t writeAmount) override;
+		bool					MovePtrAbs(size_t absLocation) override;
+
+		bool					WriteAt(const uint8_t buffer[], size_t writeAmount, size_t absLocation) override;
+		bool					IsWriteAtThreadSafe() const override;
+		bool					WriteVectored(const GFGWriteVec vectors[], size_t vectorCount) override;
+};
+#endif //__GFG_FILEWRITERPOSIX_H__
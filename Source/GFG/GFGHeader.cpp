@@ -1,7 +1,8 @@
 #include "GFGHeader.h"
+#include <algorithm>
+#include <cassert>
 
-void GFGHeader::CalculateDataOffsets(const std::vector<size_t>& meshVerticesByteSizeList,
-									 const std::vector<size_t>& meshIndicesByteSizeList)
+void GFGHeader::CalculateHeaderOffsets()
 {
 	// Clear Some Data
 	meshList.meshLocations.clear();
@@ -77,6 +78,14 @@ void GFGHeader::CalculateDataOffsets(const std::vector<size_t>& meshVerticesByte
 	headerSize += transformData.transforms.size() * sizeof(GFGTransform);
 	headerSize += sizeof(uint32_t);
 	headerSize += bonetransformData.transforms.size() * sizeof(GFGTransform);
+
+	// Extensions
+	for(const GFGHeaderExtension& extension : extensions)
+	{
+		headerSize += sizeof(uint32_t);
+		headerSize += sizeof(uint64_t);
+		headerSize += extension.data.size();
+	}
 	// Header Generation Done!
 	// -------------- //
 
@@ -95,10 +104,38 @@ void GFGHeader::CalculateDataOffsets(const std::vector<size_t>& meshVerticesByte
 	{
 		skel.boneAmount = static_cast<uint32_t>(skel.bones.size());
 	}
+	for(GFGMeshHeader& mesh : meshes)
+	{
+		mesh.headerCore.componentCount = static_cast<uint32_t>(mesh.components.size());
+	}
+	for(GFGMaterialHeader& material : materials)
+	{
+		material.headerCore.textureCount = static_cast<uint32_t>(material.textureList.size());
+		material.headerCore.unifromCount = static_cast<uint32_t>(material.uniformList.size());
+	}
+
+	// Write Transform Sizes
+	transformData.transformAmount = static_cast<uint32_t>(transformData.transforms.size());
+	bonetransformData.transformAmount = static_cast<uint32_t>(bonetransformData.transforms.size());
+}
+
+void GFGHeader::CalculateDataOffsets(const std::vector<size_t>& meshVerticesByteSizeList,
+									 const std::vector<size_t>& meshIndicesByteSizeList,
+									 uint64_t alignment)
+{
+	assert(alignment != 0 && (alignment & (alignment - 1)) == 0);
+	CalculateHeaderOffsets();
 
 	// Calculate Offsets
 	uint64_t dataOffsetPtr = 0;// headerSize;
 
+	// Offsets are relative to the header end, alignment is on the file offset
+	auto Align = [&]()
+	{
+		uint64_t fileOffset = headerSize + dataOffsetPtr;
+		dataOffsetPtr += (alignment - (fileOffset & (alignment - 1))) & (alignment - 1);
+	};
+
 	// Calculate Mesh Offsets
 	// Calculate Mesh Vertex And Index Offsets
 	// Vertex Offsets
@@ -106,14 +143,15 @@ void GFGHeader::CalculateDataOffsets(const std::vector<size_t>& meshVerticesByte
 	for(size_t i = 0; i < meshes.size(); i++)
 	{
 		GFGMeshHeader& mesh = meshes[i];
+		Align();
 		mesh.headerCore.vertexStart = dataOffsetPtr;
-		mesh.headerCore.componentCount = static_cast<uint32_t>(mesh.components.size());
 		dataOffsetPtr += meshVerticesByteSizeList[i];
 	}
 	// Index Offsets
 	for(size_t i = 0; i < meshes.size(); i++)
 	{
 		GFGMeshHeader& mesh = meshes[i];
+		Align();
 		mesh.headerCore.indexStart = dataOffsetPtr;
 		dataOffsetPtr += meshIndicesByteSizeList[i];
 	}
@@ -122,8 +160,8 @@ void GFGHeader::CalculateDataOffsets(const std::vector<size_t>& meshVerticesByte
 	// Texture
 	for(GFGMaterialHeader& material : materials)
 	{
+		Align();
 		material.headerCore.textureStart = dataOffsetPtr;
-		material.headerCore.textureCount = static_cast<uint32_t>(material.textureList.size());
 
 		for(GFGTexturePath& texPath : material.textureList)
 		{
@@ -134,8 +172,8 @@ void GFGHeader::CalculateDataOffsets(const std::vector<size_t>& meshVerticesByte
 	// Uniform
 	for(GFGMaterialHeader& material : materials)
 	{
+		Align();
 		material.headerCore.uniformStart = dataOffsetPtr;
-		material.headerCore.unifromCount = static_cast<uint32_t>(material.uniformList.size());
 
 		for(GFGUniformData& uniform : material.uniformList)
 		{
@@ -152,6 +190,7 @@ void GFGHeader::CalculateDataOffsets(const std::vector<size_t>& meshVerticesByte
 	//	optional hip translate for each keyframe-rootjoint
 	for(GFGAnimationHeader& animation : animations)
 	{
+		Align();
 		animation.dataStart = dataOffsetPtr;
 		dataOffsetPtr += animation.keyCount *
 						 sizeof(float[4]) *
@@ -161,10 +200,6 @@ void GFGHeader::CalculateDataOffsets(const std::vector<size_t>& meshVerticesByte
 		if(animation.type == GFGAnimType::WITH_HIP_TRANSLATE)
 			dataOffsetPtr += animation.keyCount * sizeof(float[3]);			// Hip Translate for each Key
 	}
-
-	// Write Transform Sizes
-	transformData.transformAmount = static_cast<uint32_t>(transformData.transforms.size());
-	bonetransformData.transformAmount = static_cast<uint32_t>(bonetransformData.transforms.size());
 }
 
 void GFGHeader::Clear()
@@ -183,4 +218,37 @@ void GFGHeader::Clear()
 	meshSkeletonConnections.connections.clear();
 	transformData.transforms.clear();
 	bonetransformData.transforms.clear();
+	extensions.clear();
+}
+
+const GFGHeaderExtension* GFGHeader::FindExtension(GFGExtensionTag tag) const
+{
+	for(const GFGHeaderExtension& extension : extensions)
+	{
+		if(extension.tag == tag) return &extension;
+	}
+	return nullptr;
+}
+
+void GFGHeader::SetExtension(GFGExtensionTag tag, std::vector<uint8_t> data)
+{
+	for(GFGHeaderExtension& extension : extensions)
+	{
+		if(extension.tag == tag)
+		{
+			extension.data = std::move(data);
+			return;
+		}
+	}
+	extensions.push_back(GFGHeaderExtension{tag, std::move(data)});
+}
+
+void GFGHeader::RemoveExtension(GFGExtensionTag tag)
+{
+	extensions.erase(std::remove_if(extensions.begin(), extensions.end(),
+									[tag](const GFGHeaderExtension& e)
+									{
+										return e.tag == tag;
+									}),
+					 extensions.end());
 }
\ No newline at end of file
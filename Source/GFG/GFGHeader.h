@@ -11,6 +11,9 @@ GFGSkeletonJumpList Structure
 GFGMeshMatPair Structure
 GFGMeshSkelPair Structure
 GFGMeshSkelPairList Structure
+GFGExtensionTag Enumeration
+GFGHeaderExtension Structure
+GFGHeaderTrailer Structure
 GFGHeader Class
 
 GFGHeader class hold the variable sized GFGHeader "serializes" data for file write
@@ -122,6 +125,46 @@ struct GFGMeshSkeletonPairList
 	std::vector<GFGMeshSkelPair>	connections;
 };
 
+// Header Extensions
+// Optional tagged sections that reside after the bone transforms
+// (until headerSize). Each section is serialized as
+// {uint32_t tag; uint64_t size; uint8_t payload[size]}
+// Readers skip the sections that they do not know, files without
+// extensions are identical to the older files.
+enum class GFGExtensionTag : uint32_t
+{
+	SPATIAL_INDEX = 1,		// World space BVH over the scene nodes (GFGSpatialIndex)
+	CHECKSUMS = 2,			// CRC32C of the header and the data blocks (GFGChecksumTable)
+	DATA_ALIGNMENT = 3		// uint64_t, absolute file offset of each data block is a multiple of it
+};
+
+struct GFGHeaderExtension
+{
+	GFGExtensionTag			tag;
+	std::vector<uint8_t>	data;
+};
+
+// Trailing Header Pointer
+// Files that are appended (GFGFileExporter::StartAppend) end with this record.
+// Active header resides at "headerLocation" (it is a complete header, its internal
+// offsets are relative to its own start) and data offsets are relative to
+// "dataLocation" (data start of the original file, so that blocks that are already
+// in the file keep their offsets). Header at the start of the file is left as is,
+// readers that do not know the trailer load the file as it was before the appends.
+static const uint32_t GFGTrailerFourCC = 'T' << 24 |
+										 'G' << 16 |
+										 'F' << 8 |
+										 'G' << 0;
+
+#pragma pack(push, 1)
+struct GFGHeaderTrailer
+{
+	uint64_t	headerLocation;		// Absolute location of the active header
+	uint64_t	dataLocation;		// Absolute location data offsets are relative to
+	uint32_t	fourCC;				// GFGTrailerFourCC
+};
+#pragma pack(pop)
+
 // Header Block
 // Variable
 class GFGHeader
@@ -155,9 +198,22 @@ class GFGHeader
 		GFGTransformList				transformData;
 		GFGTransformList				bonetransformData;			// This should be "bind pose"
 
+		// Extensions
+		std::vector<GFGHeaderExtension>	extensions;
+
 		// Utility
+		const GFGHeaderExtension*		FindExtension(GFGExtensionTag) const;
+		void							SetExtension(GFGExtensionTag, std::vector<uint8_t> data);
+		void							RemoveExtension(GFGExtensionTag);
+		// Header size, jump lists and counts (data offsets are not touched)
+		void							CalculateHeaderOffsets();
+		// Header offsets and data offsets where data blocks are laid out back to back
+		// (vertex, index, texture, uniform then animation blocks)
+		// Each block starts on a file offset (headerSize + start) that is a
+		// multiple of "alignment" (power of two), gaps are padding
 		void							CalculateDataOffsets(const std::vector<size_t>& meshVerticesByteSizeList,
-															 const std::vector<size_t>& meshIndicesByteSizeList);
+															 const std::vector<size_t>& meshIndicesByteSizeList,
+															 uint64_t alignment = 1);
 		void							Clear();
 };
 #endif //__GFG_HEADER_H__
\ No newline at end of file
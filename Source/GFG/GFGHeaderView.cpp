@@ -0,0 +1,390 @@
+#include "GFGHeaderView.h"
+#include "GFGFileLoader.h"
+#include <cassert>
+#include <cstring>
+
+// Bounds checked list fetch
+// List is a uint32_t count and "count" amount of T's
+template <class T>
+static bool FetchList(GFGSpan<const T>& list,
+					  uint64_t& dataPtr,
+					  const uint8_t data[],
+					  uint64_t headerSize)
+{
+	if(dataPtr > headerSize || headerSize - dataPtr < sizeof(uint32_t))
+		return false;
+
+	uint32_t count;
+	std::memcpy(&count, data + dataPtr, sizeof(uint32_t));
+	dataPtr += sizeof(uint32_t);
+
+	uint64_t byteSize = static_cast<uint64_t>(count) * sizeof(T);
+	if(headerSize - dataPtr < byteSize)
+		return false;
+
+	list = GFGSpan<const T>(reinterpret_cast<const T*>(data + dataPtr), count);
+	dataPtr += byteSize;
+	return true;
+}
+
+// Checks that [location, location + size) is in the header
+static bool InHeader(uint64_t location, uint64_t size, uint64_t headerSize)
+{
+	return location <= headerSize && headerSize - location >= size;
+}
+
+// Extension section {uint32_t tag; uint64_t size; payload}
+static bool FetchExtension(uint32_t& tag, GFGSpan<const uint8_t>& payload,
+						   uint64_t& dataPtr,
+						   const uint8_t data[],
+						   uint64_t headerSize)
+{
+	uint64_t size;
+	if(!InHeader(dataPtr, sizeof(uint32_t) + sizeof(uint64_t), headerSize))
+		return false;
+	std::memcpy(&tag, data + dataPtr, sizeof(uint32_t));
+	std::memcpy(&size, data + dataPtr + sizeof(uint32_t), sizeof(uint64_t));
+	dataPtr += sizeof(uint32_t) + sizeof(uint64_t);
+
+	if(!InHeader(dataPtr, size, headerSize))
+		return false;
+	payload = GFGSpan<const uint8_t>(data + dataPtr, static_cast<size_t>(size));
+	dataPtr += size;
+	return true;
+}
+
+GFGHeaderView::GFGHeaderView()
+	: data(nullptr)
+	, headerSize(0)
+	, transformJump(0)
+	, extensionStart(0)
+	, extensionCount(0)
+{}
+
+GFGFileError GFGHeaderView::Validate(const uint8_t headerData[], size_t dataSize)
+{
+	*this = GFGHeaderView();
+
+	// FourCC and Header Size
+	uint32_t fourCC;
+	uint64_t size;
+	if(sizeof(uint32_t) + sizeof(uint64_t) * 2 > dataSize)
+		return GFGFileError::FILE_CANNOT_CONTAIN_HEADER;
+	std::memcpy(&fourCC, headerData, sizeof(uint32_t));
+	std::memcpy(&size, headerData + sizeof(uint32_t), sizeof(uint64_t));
+
+	if(fourCC != GFGFourCC)
+		return GFGFileError::FILE_FOURCC_MISMATCH;
+	if(size > dataSize)
+		return GFGFileError::FILE_CANNOT_CONTAIN_HEADER;
+
+	// Transform Jump
+	uint64_t dataPtr = sizeof(uint32_t) + sizeof(uint64_t);
+	uint64_t tJump;
+	if(!InHeader(dataPtr, sizeof(uint64_t), size))
+		return GFGFileError::HEADER_CORRUPTED;
+	std::memcpy(&tJump, headerData + dataPtr, sizeof(uint64_t));
+	dataPtr += sizeof(uint64_t);
+
+	// Jump Lists, Hierarchy and Pair Lists (in order)
+	GFGHeaderView v;
+	if(!FetchList(v.meshLocations, dataPtr, headerData, size) ||
+	   !FetchList(v.materialLocations, dataPtr, headerData, size) ||
+	   !FetchList(v.skeletonLocations, dataPtr, headerData, size) ||
+	   !FetchList(v.animationLocations, dataPtr, headerData, size) ||
+	   !FetchList(v.nodes, dataPtr, headerData, size) ||
+	   !FetchList(v.meshMatPairs, dataPtr, headerData, size) ||
+	   !FetchList(v.meshSkelPairs, dataPtr, headerData, size))
+		return GFGFileError::HEADER_CORRUPTED;
+
+	// Sub Headers
+	for(uint64_t loc : v.meshLocations)
+	{
+		if(!InHeader(loc, sizeof(GFGMeshHeaderCore), size))
+			return GFGFileError::HEADER_CORRUPTED;
+		const auto& core = *reinterpret_cast<const GFGMeshHeaderCore*>(headerData + loc);
+		if(!InHeader(loc + sizeof(GFGMeshHeaderCore),
+					 static_cast<uint64_t>(core.componentCount) * sizeof(GFGVertexComponent),
+					 size))
+			return GFGFileError::HEADER_CORRUPTED;
+	}
+	for(uint64_t loc : v.materialLocations)
+	{
+		if(!InHeader(loc, sizeof(GFGMaterialHeaderCore), size))
+			return GFGFileError::HEADER_CORRUPTED;
+		const auto& core = *reinterpret_cast<const GFGMaterialHeaderCore*>(headerData + loc);
+		uint64_t listSize = static_cast<uint64_t>(core.textureCount) * sizeof(GFGTexturePath) +
+							static_cast<uint64_t>(core.unifromCount) * sizeof(GFGUniformData);
+		if(!InHeader(loc + sizeof(GFGMaterialHeaderCore), listSize, size))
+			return GFGFileError::HEADER_CORRUPTED;
+	}
+	for(uint64_t loc : v.skeletonLocations)
+	{
+		uint64_t skelPtr = loc;
+		GFGSpan<const GFGBone> bones;
+		if(!FetchList(bones, skelPtr, headerData, size))
+			return GFGFileError::HEADER_CORRUPTED;
+	}
+	for(uint64_t loc : v.animationLocations)
+	{
+		if(!InHeader(loc, sizeof(GFGAnimationHeader), size))
+			return GFGFileError::HEADER_CORRUPTED;
+	}
+
+	// Transforms
+	dataPtr = tJump;
+	if(!FetchList(v.transforms, dataPtr, headerData, size) ||
+	   !FetchList(v.boneTransforms, dataPtr, headerData, size))
+		return GFGFileError::HEADER_CORRUPTED;
+
+	// Extensions (rest of the header)
+	v.extensionStart = dataPtr;
+	while(dataPtr < size)
+	{
+		uint32_t tag;
+		GFGSpan<const uint8_t> payload;
+		if(!FetchExtension(tag, payload, dataPtr, headerData, size))
+			return GFGFileError::HEADER_CORRUPTED;
+		v.extensionCount++;
+	}
+
+	// All Fine
+	v.data = headerData;
+	v.headerSize = size;
+	v.transformJump = tJump;
+	*this = v;
+	return GFGFileError::OK;
+}
+
+bool GFGHeaderView::IsValid() const
+{
+	return data != nullptr;
+}
+
+const uint8_t* GFGHeaderView::Data() const
+{
+	return data;
+}
+
+uint64_t GFGHeaderView::HeaderSize() const
+{
+	return headerSize;
+}
+
+uint64_t GFGHeaderView::TransformJump() const
+{
+	return transformJump;
+}
+
+uint32_t GFGHeaderView::MeshCount() const
+{
+	return static_cast<uint32_t>(meshLocations.size());
+}
+
+uint32_t GFGHeaderView::MaterialCount() const
+{
+	return static_cast<uint32_t>(materialLocations.size());
+}
+
+uint32_t GFGHeaderView::SkeletonCount() const
+{
+	return static_cast<uint32_t>(skeletonLocations.size());
+}
+
+uint32_t GFGHeaderView::AnimationCount() const
+{
+	return static_cast<uint32_t>(animationLocations.size());
+}
+
+GFGSpan<const uint64_t> GFGHeaderView::MeshLocations() const
+{
+	return meshLocations;
+}
+
+GFGSpan<const uint64_t> GFGHeaderView::MaterialLocations() const
+{
+	return materialLocations;
+}
+
+GFGSpan<const uint64_t> GFGHeaderView::SkeletonLocations() const
+{
+	return skeletonLocations;
+}
+
+GFGSpan<const uint64_t> GFGHeaderView::AnimationLocations() const
+{
+	return animationLocations;
+}
+
+GFGSpan<const GFGNode> GFGHeaderView::Nodes() const
+{
+	return nodes;
+}
+
+GFGSpan<const GFGMeshMatPair> GFGHeaderView::MeshMaterialPairs() const
+{
+	return meshMatPairs;
+}
+
+GFGSpan<const GFGMeshSkelPair> GFGHeaderView::MeshSkeletonPairs() const
+{
+	return meshSkelPairs;
+}
+
+GFGSpan<const GFGTransform> GFGHeaderView::Transforms() const
+{
+	return transforms;
+}
+
+GFGSpan<const GFGTransform> GFGHeaderView::BoneTransforms() const
+{
+	return boneTransforms;
+}
+
+const GFGMeshHeaderCore& GFGHeaderView::MeshCore(uint32_t meshIndex) const
+{
+	assert(IsValid());
+	return *reinterpret_cast<const GFGMeshHeaderCore*>(data + meshLocations[meshIndex]);
+}
+
+GFGSpan<const GFGVertexComponent> GFGHeaderView::MeshComponents(uint32_t meshIndex) const
+{
+	const GFGMeshHeaderCore& core = MeshCore(meshIndex);
+	const uint8_t* compStart = reinterpret_cast<const uint8_t*>(&core) + sizeof(GFGMeshHeaderCore);
+	return GFGSpan<const GFGVertexComponent>(reinterpret_cast<const GFGVertexComponent*>(compStart),
+											 core.componentCount);
+}
+
+const GFGMaterialHeaderCore& GFGHeaderView::MaterialCore(uint32_t materialIndex) const
+{
+	assert(IsValid());
+	return *reinterpret_cast<const GFGMaterialHeaderCore*>(data + materialLocations[materialIndex]);
+}
+
+GFGSpan<const GFGTexturePath> GFGHeaderView::MaterialTextures(uint32_t materialIndex) const
+{
+	const GFGMaterialHeaderCore& core = MaterialCore(materialIndex);
+	const uint8_t* texStart = reinterpret_cast<const uint8_t*>(&core) + sizeof(GFGMaterialHeaderCore);
+	return GFGSpan<const GFGTexturePath>(reinterpret_cast<const GFGTexturePath*>(texStart),
+										 core.textureCount);
+}
+
+GFGSpan<const GFGUniformData> GFGHeaderView::MaterialUniforms(uint32_t materialIndex) const
+{
+	const GFGMaterialHeaderCore& core = MaterialCore(materialIndex);
+	const uint8_t* uniformStart = reinterpret_cast<const uint8_t*>(&core) +
+								  sizeof(GFGMaterialHeaderCore) +
+								  core.textureCount * sizeof(GFGTexturePath);
+	return GFGSpan<const GFGUniformData>(reinterpret_cast<const GFGUniformData*>(uniformStart),
+										 core.unifromCount);
+}
+
+GFGSpan<const GFGBone> GFGHeaderView::SkeletonBones(uint32_t skeletonIndex) const
+{
+	assert(IsValid());
+	const uint8_t* skelStart = data + skeletonLocations[skeletonIndex];
+	uint32_t boneAmount;
+	std::memcpy(&boneAmount, skelStart, sizeof(uint32_t));
+	return GFGSpan<const GFGBone>(reinterpret_cast<const GFGBone*>(skelStart + sizeof(uint32_t)),
+								  boneAmount);
+}
+
+const GFGAnimationHeader& GFGHeaderView::Animation(uint32_t animIndex) const
+{
+	assert(IsValid());
+	return *reinterpret_cast<const GFGAnimationHeader*>(data + animationLocations[animIndex]);
+}
+
+uint32_t GFGHeaderView::ExtensionCount() const
+{
+	return extensionCount;
+}
+
+bool GFGHeaderView::Extension(GFGSpan<const uint8_t>& payload, GFGExtensionTag tag) const
+{
+	assert(IsValid());
+	uint64_t dataPtr = extensionStart;
+	for(uint32_t i = 0; i < extensionCount; i++)
+	{
+		uint32_t t = 0;
+		FetchExtension(t, payload, dataPtr, data, headerSize);
+		if(t == static_cast<uint32_t>(tag)) return true;
+	}
+	payload = GFGSpan<const uint8_t>();
+	return false;
+}
+
+void GFGHeaderView::ToHeader(GFGHeader& header) const
+{
+	assert(IsValid());
+	header.Clear();
+
+	header.headerSize = headerSize;
+	header.transformJump = transformJump;
+
+	// Jump Lists
+	header.meshList.nodeAmount = MeshCount();
+	header.meshList.meshLocations.assign(meshLocations.begin(), meshLocations.end());
+	header.materialList.nodeAmount = MaterialCount();
+	header.materialList.materialLocations.assign(materialLocations.begin(), materialLocations.end());
+	header.skeletonList.nodeAmount = SkeletonCount();
+	header.skeletonList.skeletonLocations.assign(skeletonLocations.begin(), skeletonLocations.end());
+	header.animationList.nodeAmount = AnimationCount();
+	header.animationList.animationLocations.assign(animationLocations.begin(), animationLocations.end());
+
+	// Scene Hierarchy & Pairs
+	header.sceneHierarchy.nodeAmount = static_cast<uint32_t>(nodes.size());
+	header.sceneHierarchy.nodes.assign(nodes.begin(), nodes.end());
+	header.meshMaterialConnections.meshMatCount = static_cast<uint32_t>(meshMatPairs.size());
+	header.meshMaterialConnections.pairs.assign(meshMatPairs.begin(), meshMatPairs.end());
+	header.meshSkeletonConnections.meshSkelCount = static_cast<uint32_t>(meshSkelPairs.size());
+	header.meshSkeletonConnections.connections.assign(meshSkelPairs.begin(), meshSkelPairs.end());
+
+	// Sub Headers
+	header.meshes.resize(MeshCount());
+	for(uint32_t i = 0; i < MeshCount(); i++)
+	{
+		GFGSpan<const GFGVertexComponent> components = MeshComponents(i);
+		header.meshes[i].headerCore = MeshCore(i);
+		header.meshes[i].components.assign(components.begin(), components.end());
+	}
+	header.materials.resize(MaterialCount());
+	for(uint32_t i = 0; i < MaterialCount(); i++)
+	{
+		GFGSpan<const GFGTexturePath> textures = MaterialTextures(i);
+		GFGSpan<const GFGUniformData> uniforms = MaterialUniforms(i);
+		header.materials[i].headerCore = MaterialCore(i);
+		header.materials[i].textureList.assign(textures.begin(), textures.end());
+		header.materials[i].uniformList.assign(uniforms.begin(), uniforms.end());
+	}
+	header.skeletons.resize(SkeletonCount());
+	for(uint32_t i = 0; i < SkeletonCount(); i++)
+	{
+		GFGSpan<const GFGBone> bones = SkeletonBones(i);
+		header.skeletons[i].boneAmount = static_cast<uint32_t>(bones.size());
+		header.skeletons[i].bones.assign(bones.begin(), bones.end());
+	}
+	header.animations.resize(AnimationCount());
+	for(uint32_t i = 0; i < AnimationCount(); i++)
+	{
+		header.animations[i] = Animation(i);
+	}
+
+	// Transforms
+	header.transformData.transformAmount = static_cast<uint32_t>(transforms.size());
+	header.transformData.transforms.assign(transforms.begin(), transforms.end());
+	header.bonetransformData.transformAmount = static_cast<uint32_t>(boneTransforms.size());
+	header.bonetransformData.transforms.assign(boneTransforms.begin(), boneTransforms.end());
+
+	// Extensions
+	uint64_t dataPtr = extensionStart;
+	header.extensions.resize(extensionCount);
+	for(GFGHeaderExtension& extension : header.extensions)
+	{
+		uint32_t tag = 0;
+		GFGSpan<const uint8_t> payload;
+		FetchExtension(tag, payload, dataPtr, data, headerSize);
+		extension.tag = static_cast<GFGExtensionTag>(tag);
+		extension.data.assign(payload.begin(), payload.end());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+/**
+
+GFGHeaderView Class
+
+Non-owning, read-only view of a serialized GFG header.
+
+Validate does a single bounds-checked pass over the header bytes
+(no allocations, no copies) and afterwards lists and sub-headers are
+accessed directly from the given memory. Memory can be a file mapping
+(GFGFileReaderMMap::MappedData) or any user buffer that holds the
+header. It should outlive the view.
+
+Like the GFGFileLoader, structures are accessed in-place; header
+offsets are not aligned so platform should support unaligned access.
+
+For License refer to:
+https://github.com/yalcinerbora/GFGFileFormat/blob/master/LICENSE
+*/
+
+#ifndef __GFG_HEADERVIEW_H__
+#define __GFG_HEADERVIEW_H__
+
+#include "GFGHeader.h"
+#include "GFGSpan.h"
+
+enum class GFGFileError;
+
+class GFGHeaderView
+{
+	private:
+		const uint8_t*						data;
+		uint64_t							headerSize;
+		uint64_t							transformJump;
+
+		GFGSpan<const uint64_t>				meshLocations;
+		GFGSpan<const uint64_t>				materialLocations;
+		GFGSpan<const uint64_t>				skeletonLocations;
+		GFGSpan<const uint64_t>				animationLocations;
+
+		GFGSpan<const GFGNode>				nodes;
+		GFGSpan<const GFGMeshMatPair>		meshMatPairs;
+		GFGSpan<const GFGMeshSkelPair>		meshSkelPairs;
+
+		GFGSpan<const GFGTransform>			transforms;
+		GFGSpan<const GFGTransform>			boneTransforms;
+
+		uint64_t							extensionStart;
+		uint32_t							extensionCount;
+
+	protected:
+	public:
+		// Constructors & Destructor
+											GFGHeaderView();
+											~GFGHeaderView() = default;
+
+		// Validation
+		// "headerData" should start with the fourCC and hold atleast
+		// "headerSize" bytes, dataSize is the accessible size of the memory
+		GFGFileError						Validate(const uint8_t headerData[], size_t dataSize);
+		bool								IsValid() const;
+
+		// Access
+		const uint8_t*						Data() const;
+		uint64_t							HeaderSize() const;
+		uint64_t							TransformJump() const;
+
+		uint32_t							MeshCount() const;
+		uint32_t							MaterialCount() const;
+		uint32_t							SkeletonCount() const;
+		uint32_t							AnimationCount() const;
+
+		GFGSpan<const uint64_t>				MeshLocations() const;
+		GFGSpan<const uint64_t>				MaterialLocations() const;
+		GFGSpan<const uint64_t>				SkeletonLocations() const;
+		GFGSpan<const uint64_t>				AnimationLocations() const;
+
+		GFGSpan<const GFGNode>				Nodes() const;
+		GFGSpan<const GFGMeshMatPair>		MeshMaterialPairs() const;
+		GFGSpan<const GFGMeshSkelPair>		MeshSkeletonPairs() const;
+
+		GFGSpan<const GFGTransform>			Transforms() const;
+		GFGSpan<const GFGTransform>			BoneTransforms() const;
+
+		// Sub Headers
+		const GFGMeshHeaderCore&			MeshCore(uint32_t meshIndex) const;
+		GFGSpan<const GFGVertexComponent>	MeshComponents(uint32_t meshIndex) const;
+
+		const GFGMaterialHeaderCore&		MaterialCore(uint32_t materialIndex) const;
+		GFGSpan<const GFGTexturePath>		MaterialTextures(uint32_t materialIndex) const;
+		GFGSpan<const GFGUniformData>		MaterialUniforms(uint32_t materialIndex) const;
+
+		GFGSpan<const GFGBone>				SkeletonBones(uint32_t skeletonIndex) const;
+
+		const GFGAnimationHeader&			Animation(uint32_t animIndex) const;
+
+		// Extensions
+		// Returns false if header does not have the extension
+		uint32_t							ExtensionCount() const;
+		bool								Extension(GFGSpan<const uint8_t>& payload,
+													  GFGExtensionTag) const;
+
+		// Materialization (copies everything to the owning header)
+		void								ToHeader(GFGHeader&) const;
+};
+#endif //__GFG_HEADERVIEW_H__
\ No newline at end of file
@@ -3,6 +3,7 @@
 GFGVertexComponent Structure
 GFGMeshHeaderCore Structure
 GFGMeshHeader Structure
+GFGComponentStride Function
 
 Mesh Releated Structures used by GFGHeader class.
 
@@ -74,4 +75,13 @@ static_assert (sizeof(GFGVertexComponent) ==
 			   "Vertex Component Size Mismatch from GFG Definition");
 
 #pragma pack(pop)
+
+// Byte distance between consecutive elements of the component
+// Zero stride is tightly packed (elements are a single data type apart)
+inline uint64_t GFGComponentStride(const GFGVertexComponent& component)
+{
+	return (component.stride == 0)
+			? GFGDataTypeByteSize[static_cast<uint32_t>(component.dataType)]
+			: component.stride;
+}
 #endif //__GFG_MESHHEADER_H__
\ No newline at end of file
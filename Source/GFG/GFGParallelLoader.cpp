@@ -0,0 +1,372 @@
+#include "GFGParallelLoader.h"
+#include "GFGChecksum.h"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <memory>
+
+namespace
+{
+	struct LoadChunk
+	{
+		uint32_t		requestIndex;
+		GFGBlockType	type;
+		uint32_t		index;
+		uint8_t*		data;
+		uint64_t		byteOffset;
+		uint64_t		byteCount;
+		// Whole vertex block is transcoded to this layout (not chunked)
+		const std::vector<GFGVertexComponent>*	layout;
+	};
+
+	struct LoadState
+	{
+		std::vector<GFGLoadRequest>					requests;
+		GFGLoadCallback								callback;
+
+		// Inline verification (chunks of a request are consecutive)
+		bool										verify;
+		std::vector<LoadChunk>						chunks;
+		std::vector<uint32_t>						firstChunk;
+		std::unique_ptr<uint32_t[]>					chunkChecksums;
+
+		// Per request
+		std::unique_ptr<std::atomic<uint32_t>[]>	remainingChunks;
+		std::unique_ptr<std::atomic<GFGFileError>[]>	requestErrors;
+
+		// Overall
+		std::atomic<size_t>							remainingRequests;
+		std::atomic<GFGFileError>					firstError;
+		std::promise<GFGFileError>					promise;
+	};
+
+	void SetError(std::atomic<GFGFileError>& e, GFGFileError error)
+	{
+		GFGFileError expected = GFGFileError::OK;
+		e.compare_exchange_strong(expected, error);
+	}
+
+	// Combines the chunk checksums of each block of the request
+	GFGFileError VerifyRequest(const GFGFileLoader& loader, const LoadState& state,
+							   uint32_t requestIndex)
+	{
+		uint32_t end = (requestIndex + 1 < state.firstChunk.size())
+							? state.firstChunk[requestIndex + 1]
+							: static_cast<uint32_t>(state.chunks.size());
+		for(uint32_t i = state.firstChunk[requestIndex]; i < end;)
+		{
+			const LoadChunk& first = state.chunks[i];
+			// Transcoded data is not the stored block
+			if(first.layout)
+			{
+				i++;
+				continue;
+			}
+			uint32_t checksum = state.chunkChecksums[i];
+			for(i++; i < end && state.chunks[i].type == first.type; i++)
+				checksum = GFGCrc32CCombine(checksum, state.chunkChecksums[i],
+											state.chunks[i].byteCount);
+
+			uint32_t expected;
+			GFGFileError error = loader.BlockChecksum(expected, first.type, first.index);
+			if(error == GFGFileError::HEADER_EXTENSION_NOT_FOUND) return GFGFileError::OK;
+			if(error != GFGFileError::OK) return error;
+			if(checksum != expected) return GFGFileError::CHECKSUM_MISMATCH;
+		}
+		return GFGFileError::OK;
+	}
+
+	void FinishRequest(const GFGFileLoader& loader, LoadState& state, uint32_t requestIndex)
+	{
+		if(state.verify && state.requestErrors[requestIndex] == GFGFileError::OK)
+		{
+			GFGFileError error = VerifyRequest(loader, state, requestIndex);
+			if(error != GFGFileError::OK)
+			{
+				SetError(state.requestErrors[requestIndex], error);
+				SetError(state.firstError, error);
+			}
+		}
+
+		GFGFileError error = state.requestErrors[requestIndex];
+		if(state.callback) state.callback(state.requests[requestIndex], error);
+		if(--state.remainingRequests == 0)
+			state.promise.set_value(state.firstError);
+	}
+
+	void LoadChunkData(const GFGFileLoader& loader, LoadState& state, uint32_t chunkIndex)
+	{
+		const LoadChunk& chunk = state.chunks[chunkIndex];
+		GFGFileError error;
+		if(chunk.layout)
+			error = loader.MeshVertexDataTranscoded(chunk.data, chunk.index, *chunk.layout);
+		else
+			error = loader.BlockDataRange(chunk.data + chunk.byteOffset,
+										  chunk.type, chunk.index,
+										  chunk.byteOffset, chunk.byteCount);
+		if(error != GFGFileError::OK)
+		{
+			SetError(state.requestErrors[chunk.requestIndex], error);
+			SetError(state.firstError, error);
+		}
+		// Data is still in cache
+		else if(state.verify && !chunk.layout)
+		{
+			state.chunkChecksums[chunkIndex] = GFGCrc32C(chunk.data + chunk.byteOffset,
+														 static_cast<size_t>(chunk.byteCount));
+		}
+		if(--state.remainingChunks[chunk.requestIndex] == 0)
+			FinishRequest(loader, state, chunk.requestIndex);
+	}
+
+	struct ScrubChunk
+	{
+		uint32_t		blockIndex;
+		uint64_t		byteOffset;
+		uint64_t		byteCount;
+	};
+
+	struct ScrubBlock
+	{
+		GFGBlockType	type;
+		uint32_t		index;
+		uint32_t		firstChunk;
+		uint32_t		chunkCount;
+	};
+
+	struct ScrubState
+	{
+		std::vector<ScrubBlock>						blocks;
+		std::vector<ScrubChunk>						chunks;
+		GFGScrubCallback							callback;
+
+		std::unique_ptr<uint32_t[]>					chunkChecksums;
+		std::unique_ptr<std::atomic<uint32_t>[]>	remainingChunks;
+		std::unique_ptr<std::atomic<GFGFileError>[]>	blockErrors;
+
+		std::atomic<size_t>							remainingBlocks;
+		std::atomic<GFGFileError>					firstError;
+		std::promise<GFGFileError>					promise;
+	};
+
+	void FinishBlock(const GFGFileLoader& loader, ScrubState& state, uint32_t blockIndex)
+	{
+		const ScrubBlock& block = state.blocks[blockIndex];
+		if(state.blockErrors[blockIndex] == GFGFileError::OK)
+		{
+			uint32_t checksum = 0;
+			for(uint32_t i = block.firstChunk; i < block.firstChunk + block.chunkCount; i++)
+				checksum = GFGCrc32CCombine(checksum, state.chunkChecksums[i],
+											state.chunks[i].byteCount);
+			uint32_t expected;
+			GFGFileError error = loader.BlockChecksum(expected, block.type, block.index);
+			if(error == GFGFileError::OK && checksum != expected)
+				error = GFGFileError::CHECKSUM_MISMATCH;
+			SetError(state.blockErrors[blockIndex], error);
+		}
+
+		GFGFileError error = state.blockErrors[blockIndex];
+		SetError(state.firstError, error);
+		if(state.callback) state.callback(block.type, block.index, error);
+		if(--state.remainingBlocks == 0)
+			state.promise.set_value(state.firstError);
+	}
+
+	void ScrubChunkData(const GFGFileLoader& loader, ScrubState& state, uint32_t chunkIndex)
+	{
+		const ScrubChunk& chunk = state.chunks[chunkIndex];
+		const ScrubBlock& block = state.blocks[chunk.blockIndex];
+		GFGFileError error = loader.BlockRangeChecksum(state.chunkChecksums[chunkIndex],
+													   block.type, block.index,
+													   chunk.byteOffset, chunk.byteCount);
+		if(error != GFGFileError::OK)
+			SetError(state.blockErrors[chunk.blockIndex], error);
+		if(--state.remainingChunks[chunk.blockIndex] == 0)
+			FinishBlock(loader, state, chunk.blockIndex);
+	}
+}
+
+GFGParallelLoader::GFGParallelLoader(const GFGFileLoader& loader,
+									 GFGThreadPool& threadPool,
+									 uint64_t chunkSize)
+	: loader(loader)
+	, threadPool(threadPool)
+	, chunkSize(chunkSize)
+{
+	assert(chunkSize != 0);
+}
+
+std::future<GFGFileError> GFGParallelLoader::Load(std::vector<GFGLoadRequest> requests,
+												  GFGLoadCallback callback)
+{
+	auto state = std::make_shared<LoadState>();
+	state->requests = std::move(requests);
+	state->callback = std::move(callback);
+	state->firstError = GFGFileError::OK;
+	state->verify = loader.VerifyOnLoad();
+
+	size_t requestCount = state->requests.size();
+	state->remainingChunks = std::make_unique<std::atomic<uint32_t>[]>(requestCount);
+	state->requestErrors = std::make_unique<std::atomic<GFGFileError>[]>(requestCount);
+	state->remainingRequests = requestCount;
+	std::future<GFGFileError> future = state->promise.get_future();
+	if(requestCount == 0)
+	{
+		state->promise.set_value(GFGFileError::OK);
+		return future;
+	}
+
+	// Generate Chunks
+	std::vector<LoadChunk>& chunks = state->chunks;
+	state->firstChunk.resize(requestCount);
+	for(uint32_t i = 0; i < static_cast<uint32_t>(requestCount); i++)
+	{
+		const GFGLoadRequest& r = state->requests[i];
+		state->firstChunk[i] = static_cast<uint32_t>(chunks.size());
+		std::pair<GFGBlockType, uint8_t*> blocks[2];
+		int blockCount = 0;
+		switch(r.type)
+		{
+			case GFGLoadType::MESH:
+				blocks[blockCount++] = {GFGBlockType::MESH_VERTEX, r.data};
+				blocks[blockCount++] = {GFGBlockType::MESH_INDEX, r.auxData};
+				break;
+			case GFGLoadType::MATERIAL:
+				blocks[blockCount++] = {GFGBlockType::MATERIAL_TEXTURE, r.data};
+				blocks[blockCount++] = {GFGBlockType::MATERIAL_UNIFORM, r.auxData};
+				break;
+			case GFGLoadType::ANIMATION:
+				blocks[blockCount++] = {GFGBlockType::ANIMATION_KEYFRAME, r.data};
+				break;
+		}
+
+		uint32_t chunkCount = 0;
+		for(int j = 0; j < blockCount; j++)
+		{
+			if(blocks[j].second == nullptr) continue;
+			if(blocks[j].first == GFGBlockType::MESH_VERTEX && r.vertexLayout)
+			{
+				chunks.push_back(LoadChunk{i, blocks[j].first, r.index,
+										   blocks[j].second, 0, 0, r.vertexLayout});
+				chunkCount++;
+				continue;
+			}
+			uint64_t blockSize = loader.BlockSize(blocks[j].first, r.index);
+			for(uint64_t offset = 0; offset < blockSize; offset += chunkSize)
+			{
+				uint64_t count = std::min(chunkSize, blockSize - offset);
+				chunks.push_back(LoadChunk{i, blocks[j].first, r.index,
+										   blocks[j].second, offset, count, nullptr});
+				chunkCount++;
+			}
+		}
+		state->remainingChunks[i] = chunkCount;
+		state->requestErrors[i] = GFGFileError::OK;
+	}
+
+	state->chunkChecksums = std::make_unique<uint32_t[]>(chunks.size());
+
+	// Empty requests are already complete
+	for(uint32_t i = 0; i < static_cast<uint32_t>(requestCount); i++)
+	{
+		if(state->remainingChunks[i] == 0) FinishRequest(loader, *state, i);
+	}
+
+	// Reader cannot be used concurrently, load on this thread
+	uint32_t chunkCount = static_cast<uint32_t>(chunks.size());
+	if(!loader.IsConcurrent())
+	{
+		for(uint32_t i = 0; i < chunkCount; i++)
+			LoadChunkData(loader, *state, i);
+		return future;
+	}
+
+	const GFGFileLoader& l = loader;
+	for(uint32_t i = 0; i < chunkCount; i++)
+	{
+		threadPool.Submit([&l, state, i]()
+		{
+			LoadChunkData(l, *state, i);
+		});
+	}
+	return future;
+}
+
+std::future<GFGFileError> GFGParallelLoader::Scrub(GFGScrubCallback callback)
+{
+	auto state = std::make_shared<ScrubState>();
+	state->callback = std::move(callback);
+	state->firstError = GFGFileError::OK;
+	std::future<GFGFileError> future = state->promise.get_future();
+
+	// Header (also checks that the file has checksums)
+	GFGFileError error = loader.VerifyHeader();
+	if(error != GFGFileError::OK)
+	{
+		state->promise.set_value(error);
+		return future;
+	}
+
+	// Blocks (in checksum table order)
+	auto AddBlocks = [&](GFGBlockType type, uint32_t count)
+	{
+		for(uint32_t i = 0; i < count; i++)
+		{
+			ScrubBlock block = {type, i, static_cast<uint32_t>(state->chunks.size()), 0};
+			uint32_t blockIndex = static_cast<uint32_t>(state->blocks.size());
+			uint64_t blockSize = loader.BlockSize(type, i);
+			for(uint64_t offset = 0; offset < blockSize; offset += chunkSize)
+			{
+				uint64_t size = std::min(chunkSize, blockSize - offset);
+				state->chunks.push_back(ScrubChunk{blockIndex, offset, size});
+				block.chunkCount++;
+			}
+			state->blocks.push_back(block);
+		}
+	};
+	AddBlocks(GFGBlockType::MESH_VERTEX, loader.MeshCount());
+	AddBlocks(GFGBlockType::MESH_INDEX, loader.MeshCount());
+	AddBlocks(GFGBlockType::MATERIAL_TEXTURE, loader.MaterialCount());
+	AddBlocks(GFGBlockType::MATERIAL_UNIFORM, loader.MaterialCount());
+	AddBlocks(GFGBlockType::ANIMATION_KEYFRAME, loader.AnimationCount());
+
+	size_t blockCount = state->blocks.size();
+	size_t chunkCount = state->chunks.size();
+	state->chunkChecksums = std::make_unique<uint32_t[]>(chunkCount);
+	state->remainingChunks = std::make_unique<std::atomic<uint32_t>[]>(blockCount);
+	state->blockErrors = std::make_unique<std::atomic<GFGFileError>[]>(blockCount);
+	state->remainingBlocks = blockCount;
+	for(size_t i = 0; i < blockCount; i++)
+	{
+		state->remainingChunks[i] = state->blocks[i].chunkCount;
+		state->blockErrors[i] = GFGFileError::OK;
+	}
+	if(blockCount == 0)
+	{
+		state->promise.set_value(GFGFileError::OK);
+		return future;
+	}
+
+	// Empty blocks are verified directly
+	for(uint32_t i = 0; i < static_cast<uint32_t>(blockCount); i++)
+	{
+		if(state->blocks[i].chunkCount == 0) FinishBlock(loader, *state, i);
+	}
+
+	if(!loader.IsConcurrent())
+	{
+		for(uint32_t i = 0; i < static_cast<uint32_t>(chunkCount); i++)
+			ScrubChunkData(loader, *state, i);
+		return future;
+	}
+
+	const GFGFileLoader& l = loader;
+	for(uint32_t i = 0; i < static_cast<uint32_t>(chunkCount); i++)
+	{
+		threadPool.Submit([&l, state, i]()
+		{
+			ScrubChunkData(l, *state, i);
+		});
+	}
+	return future;
+}
\ No newline at end of file
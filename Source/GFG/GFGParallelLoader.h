@@ -0,0 +1,94 @@
+/**
+
+GFGLoadRequest Struct
+GFGParallelLoader Class
+
+GFGParallelLoader loads multiple meshes/materials/animations concurrently
+using a GFGThreadPool. Large data blocks are split into chunks so that
+a single large mesh is also read by multiple threads.
+
+Mesh requests can give a vertex layout, vertex data is then transcoded to
+that layout (GFGFileLoader::MeshVertexDataTranscoded) directly into the
+destination as a single task of the pool instead of being read in chunks.
+
+Callback is called (from a worker thread) as soon as all blocks of a request
+are loaded, so that user can start using (i.e. uploading to the GPU)
+the data while the rest is still being loaded. Returned future is fulfilled
+when all of the requests are completed.
+
+If the loader verifies on load (GFGFileLoader::SetVerifyOnLoad), checksum
+of each chunk is calculated right after its read and chunk checksums are
+combined to the block checksum when the request is completed. Transcoded
+vertex data is not verified (same as the loader).
+
+Scrub verifies the header and every data block of the file against the
+stored checksums, blocks (and chunks of large blocks) are verified in parallel.
+
+Loader's reader should support thread safe positional reads
+(GFGFileLoader::IsConcurrent), if not requests are loaded serially
+on the calling thread.
+
+For License refer to:
+https://github.com/yalcinerbora/GFGFileFormat/blob/master/LICENSE
+*/
+
+#ifndef __GFG_PARALLELLOADER_H__
+#define __GFG_PARALLELLOADER_H__
+
+#include <functional>
+#include <future>
+#include <vector>
+
+#include "GFGFileLoader.h"
+#include "GFGThreadPool.h"
+
+enum class GFGLoadType
+{
+	MESH,			// data: vertex data, auxData: index data
+	MATERIAL,		// data: texture path data, auxData: uniform data
+	ANIMATION		// data: keyframe data, auxData: unused
+};
+
+struct GFGLoadRequest
+{
+	GFGLoadType		type;
+	uint32_t		index;		// Mesh, Material or Animation index
+	uint8_t*		data;		// Can be nullptr (that block is skipped)
+	uint8_t*		auxData;	// Can be nullptr (that block is skipped)
+	// Meshes only, if not nullptr vertex data is transcoded to this layout
+	// (should live until the request is completed)
+	const std::vector<GFGVertexComponent>*	vertexLayout = nullptr;
+};
+
+using GFGLoadCallback = std::function<void(const GFGLoadRequest&, GFGFileError)>;
+using GFGScrubCallback = std::function<void(GFGBlockType, uint32_t index, GFGFileError)>;
+
+class GFGParallelLoader
+{
+	private:
+		const GFGFileLoader&				loader;
+		GFGThreadPool&						threadPool;
+		uint64_t							chunkSize;
+
+	protected:
+	public:
+		static constexpr uint64_t			DefaultChunkSize = 4 * 1024 * 1024;
+
+		// Constructors & Destructor
+											GFGParallelLoader(const GFGFileLoader& loader,
+															  GFGThreadPool& threadPool,
+															  uint64_t chunkSize = DefaultChunkSize);
+											~GFGParallelLoader() = default;
+
+		// Loading
+		// Future holds OK or the first error that is encountered
+		std::future<GFGFileError>			Load(std::vector<GFGLoadRequest> requests,
+												 GFGLoadCallback callback = nullptr);
+		// Verification
+		// Header is verified on the calling thread (future is fulfilled immediately
+		// if the header is corrupted or file does not have checksums), then callback
+		// is called for each block as soon as it is verified
+		std::future<GFGFileError>			Scrub(GFGScrubCallback callback = nullptr);
+};
+
+#endif //__GFG_PARALLELLOADER_H__
\ No newline at end of file
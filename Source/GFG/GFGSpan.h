@@ -0,0 +1,63 @@
+/**
+
+GFGSpan Class
+
+Non-owning view over a contiguous memory region.
+
+Library is C++17 so std::span is not available, this is the minimal
+subset of it that is used by GFG (names are kept same as std::span
+so that it can be swapped later).
+
+For License refer to:
+https://github.com/yalcinerbora/GFGFileFormat/blob/master/LICENSE
+*/
+
+#ifndef __GFG_SPAN_H__
+#define __GFG_SPAN_H__
+
+#include <cstddef>
+#include <cassert>
+#include <vector>
+#include <type_traits>
+
+template<class T>
+class GFGSpan
+{
+	private:
+		T*						ptr;
+		size_t					count;
+
+	protected:
+	public:
+		// Constructors & Destructor
+		constexpr				GFGSpan() : ptr(nullptr), count(0) {}
+		constexpr				GFGSpan(T* data, size_t size) : ptr(data), count(size) {}
+		template<class U, class = std::enable_if_t<std::is_const_v<T> &&
+												   std::is_same_v<std::remove_const_t<T>, U>>>
+								GFGSpan(const std::vector<U>& v) : ptr(v.data()), count(v.size()) {}
+		template<class U, class = std::enable_if_t<std::is_same_v<T, U>>>
+								GFGSpan(std::vector<U>& v) : ptr(v.data()), count(v.size()) {}
+		// Non-const to const conversion
+		template<class U, class = std::enable_if_t<std::is_same_v<const U, T> &&
+												   !std::is_same_v<U, T>>>
+		constexpr				GFGSpan(const GFGSpan<U>& s) : ptr(s.data()), count(s.size()) {}
+
+		// Access
+		constexpr T*			data() const { return ptr; }
+		constexpr size_t		size() const { return count; }
+		constexpr size_t		size_bytes() const { return count * sizeof(T); }
+		constexpr bool			empty() const { return count == 0; }
+
+		constexpr T*			begin() const { return ptr; }
+		constexpr T*			end() const { return ptr + count; }
+
+		T&						operator[](size_t i) const { assert(i < count); return ptr[i]; }
+
+		GFGSpan					subspan(size_t offset, size_t subCount) const
+		{
+			assert(offset + subCount <= count);
+			return GFGSpan(ptr + offset, subCount);
+		}
+};
+
+#endif //__GFG_SPAN_H__
\ No newline at end of file
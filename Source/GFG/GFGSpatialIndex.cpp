@@ -0,0 +1,343 @@
+#include "GFGSpatialIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+	// Affine transform (3x3 linear part and translation, column vectors)
+	struct Affine
+	{
+		float	m[3][3];
+		float	t[3];
+	};
+
+	const Affine Identity =
+	{
+		{{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}},
+		{0.0f, 0.0f, 0.0f}
+	};
+
+	const GFGAABB EmptyAABB =
+	{
+		{std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max()},
+		{-std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()}
+	};
+
+	Affine Multiply(const Affine& a, const Affine& b)
+	{
+		Affine r;
+		for(int i = 0; i < 3; i++)
+		{
+			for(int j = 0; j < 3; j++)
+			{
+				r.m[i][j] = a.m[i][0] * b.m[0][j] +
+							a.m[i][1] * b.m[1][j] +
+							a.m[i][2] * b.m[2][j];
+			}
+			r.t[i] = a.m[i][0] * b.t[0] +
+					 a.m[i][1] * b.t[1] +
+					 a.m[i][2] * b.t[2] + a.t[i];
+		}
+		return r;
+	}
+
+	// Scale then rotate (X, Y then Z) then translate
+	Affine LocalTransform(const GFGTransform& transform)
+	{
+		float cx = std::cos(transform.rotate[0]), sx = std::sin(transform.rotate[0]);
+		float cy = std::cos(transform.rotate[1]), sy = std::sin(transform.rotate[1]);
+		float cz = std::cos(transform.rotate[2]), sz = std::sin(transform.rotate[2]);
+
+		// Rz * Ry * Rx
+		float r[3][3] =
+		{
+			{cz * cy, cz * sy * sx - sz * cx, cz * sy * cx + sz * sx},
+			{sz * cy, sz * sy * sx + cz * cx, sz * sy * cx - cz * sx},
+			{-sy,     cy * sx,                cy * cx}
+		};
+
+		Affine result;
+		for(int i = 0; i < 3; i++)
+		{
+			for(int j = 0; j < 3; j++)
+				result.m[i][j] = r[i][j] * transform.scale[j];
+			result.t[i] = transform.translate[i];
+		}
+		return result;
+	}
+
+	bool IsEmpty(const GFGAABB& aabb)
+	{
+		return aabb.min[0] > aabb.max[0] ||
+			   aabb.min[1] > aabb.max[1] ||
+			   aabb.min[2] > aabb.max[2];
+	}
+
+	GFGAABB TransformAABB(const Affine& a, const GFGAABB& aabb)
+	{
+		GFGAABB result;
+		for(int i = 0; i < 3; i++)
+		{
+			result.min[i] = a.t[i];
+			result.max[i] = a.t[i];
+			for(int j = 0; j < 3; j++)
+			{
+				float e0 = a.m[i][j] * aabb.min[j];
+				float e1 = a.m[i][j] * aabb.max[j];
+				result.min[i] += std::min(e0, e1);
+				result.max[i] += std::max(e0, e1);
+			}
+		}
+		return result;
+	}
+
+	void Union(GFGAABB& a, const GFGAABB& b)
+	{
+		for(int i = 0; i < 3; i++)
+		{
+			a.min[i] = std::min(a.min[i], b.min[i]);
+			a.max[i] = std::max(a.max[i], b.max[i]);
+		}
+	}
+
+	bool Intersects(const GFGAABB& a, const GFGAABB& b)
+	{
+		return a.min[0] <= b.max[0] && a.max[0] >= b.min[0] &&
+			   a.min[1] <= b.max[1] && a.max[1] >= b.min[1] &&
+			   a.min[2] <= b.max[2] && a.max[2] >= b.min[2];
+	}
+
+	// Box is outside if it is completely behind any of the planes
+	bool Intersects(const GFGFrustum& f, const GFGAABB& aabb)
+	{
+		for(const float (&p)[4] : f.planes)
+		{
+			float x = (p[0] >= 0.0f) ? aabb.max[0] : aabb.min[0];
+			float y = (p[1] >= 0.0f) ? aabb.max[1] : aabb.min[1];
+			float z = (p[2] >= 0.0f) ? aabb.max[2] : aabb.min[2];
+			if(p[0] * x + p[1] * y + p[2] * z + p[3] < 0.0f)
+				return false;
+		}
+		return true;
+	}
+
+	template <class Volume>
+	void Traverse(std::vector<GFGSpatialItem>& result,
+				  GFGSpan<const GFGBVHNode> nodes,
+				  GFGSpan<const GFGSpatialItem> items,
+				  const Volume& volume)
+	{
+		if(nodes.empty()) return;
+
+		std::vector<uint32_t> stack;
+		stack.push_back(0);
+		while(!stack.empty())
+		{
+			const GFGBVHNode& node = nodes[stack.back()];
+			uint32_t nodeIndex = stack.back();
+			stack.pop_back();
+			if(!Intersects(volume, node.aabb)) continue;
+
+			if(node.count == 0)
+			{
+				stack.push_back(node.first);
+				stack.push_back(nodeIndex + 1);
+				continue;
+			}
+			for(uint32_t i = node.first; i < node.first + node.count; i++)
+			{
+				if(Intersects(volume, items[i].aabb))
+					result.push_back(items[i]);
+			}
+		}
+	}
+}
+
+uint32_t GFGSpatialIndex::BuildRecursive(uint32_t first, uint32_t count)
+{
+	uint32_t nodeIndex = static_cast<uint32_t>(nodes.size());
+	nodes.push_back(GFGBVHNode{EmptyAABB, first, count});
+
+	GFGAABB bounds = EmptyAABB;
+	GFGAABB centroidBounds = EmptyAABB;
+	for(uint32_t i = first; i < first + count; i++)
+	{
+		const GFGAABB& aabb = items[i].aabb;
+		GFGAABB centroid;
+		for(int j = 0; j < 3; j++)
+		{
+			centroid.min[j] = centroid.max[j] = (aabb.min[j] + aabb.max[j]) * 0.5f;
+		}
+		Union(bounds, aabb);
+		Union(centroidBounds, centroid);
+	}
+	nodes[nodeIndex].aabb = bounds;
+	if(count <= LeafSize) return nodeIndex;
+
+	// Median split on the largest centroid axis
+	int axis = 0;
+	for(int j = 1; j < 3; j++)
+	{
+		if(centroidBounds.max[j] - centroidBounds.min[j] >
+		   centroidBounds.max[axis] - centroidBounds.min[axis])
+			axis = j;
+	}
+	uint32_t half = count / 2;
+	std::nth_element(items.begin() + first,
+					 items.begin() + first + half,
+					 items.begin() + first + count,
+					 [axis](const GFGSpatialItem& a, const GFGSpatialItem& b)
+	{
+		return (a.aabb.min[axis] + a.aabb.max[axis]) < (b.aabb.min[axis] + b.aabb.max[axis]);
+	});
+
+	BuildRecursive(first, half);
+	uint32_t right = BuildRecursive(first + half, count - half);
+	nodes[nodeIndex].first = right;
+	nodes[nodeIndex].count = 0;
+	return nodeIndex;
+}
+
+void GFGSpatialIndex::WorldBounds(std::vector<GFGAABB>& nodeBounds, const GFGHeader& header)
+{
+	const std::vector<GFGNode>& hierarchy = header.sceneHierarchy.nodes;
+	const std::vector<GFGTransform>& transforms = header.transformData.transforms;
+	uint32_t nodeCount = static_cast<uint32_t>(hierarchy.size());
+
+	// World transforms, parents are resolved iteratively
+	// (parent index that is out of range is the root)
+	enum : uint8_t { UNVISITED, VISITING, DONE };
+	std::vector<Affine> world(nodeCount);
+	std::vector<uint8_t> states(nodeCount, UNVISITED);
+	std::vector<uint32_t> chain;
+	for(uint32_t i = 0; i < nodeCount; i++)
+	{
+		chain.clear();
+		uint32_t current = i;
+		while(current < nodeCount && states[current] == UNVISITED)
+		{
+			states[current] = VISITING;
+			chain.push_back(current);
+			current = hierarchy[current].parentIndex;
+		}
+		// Cyclic hierarchies are cut where the cycle is found
+		Affine parent = (current < nodeCount && states[current] == DONE) ? world[current] : Identity;
+		for(auto it = chain.rbegin(); it != chain.rend(); it++)
+		{
+			uint32_t transformIndex = hierarchy[*it].transformIndex;
+			Affine local = (transformIndex < transforms.size())
+								? LocalTransform(transforms[transformIndex])
+								: Identity;
+			world[*it] = Multiply(parent, local);
+			states[*it] = DONE;
+			parent = world[*it];
+		}
+	}
+
+	nodeBounds.assign(nodeCount, EmptyAABB);
+	for(uint32_t i = 0; i < nodeCount; i++)
+	{
+		uint32_t meshIndex = hierarchy[i].meshReference;
+		if(meshIndex >= header.meshes.size()) continue;
+
+		const GFGAABB& aabb = header.meshes[meshIndex].headerCore.aabb;
+		if(IsEmpty(aabb)) continue;
+		nodeBounds[i] = TransformAABB(world[i], aabb);
+	}
+}
+
+void GFGSpatialIndex::Build(const GFGHeader& header)
+{
+	Clear();
+
+	std::vector<GFGAABB> nodeBounds;
+	WorldBounds(nodeBounds, header);
+	for(uint32_t i = 0; i < static_cast<uint32_t>(nodeBounds.size()); i++)
+	{
+		if(IsEmpty(nodeBounds[i])) continue;
+		items.push_back(GFGSpatialItem{nodeBounds[i], i, header.sceneHierarchy.nodes[i].meshReference});
+	}
+	if(items.empty()) return;
+	BuildRecursive(0, static_cast<uint32_t>(items.size()));
+}
+
+void GFGSpatialIndex::Serialize(std::vector<uint8_t>& data) const
+{
+	uint32_t nodeCount = static_cast<uint32_t>(nodes.size());
+	uint32_t itemCount = static_cast<uint32_t>(items.size());
+	size_t nodeSize = nodes.size() * sizeof(GFGBVHNode);
+	size_t itemSize = items.size() * sizeof(GFGSpatialItem);
+
+	data.resize(sizeof(uint32_t) * 2 + nodeSize + itemSize);
+	uint8_t* ptr = data.data();
+	std::memcpy(ptr, &nodeCount, sizeof(uint32_t));
+	ptr += sizeof(uint32_t);
+	std::memcpy(ptr, &itemCount, sizeof(uint32_t));
+	ptr += sizeof(uint32_t);
+	if(nodeSize != 0) std::memcpy(ptr, nodes.data(), nodeSize);
+	ptr += nodeSize;
+	if(itemSize != 0) std::memcpy(ptr, items.data(), itemSize);
+}
+
+bool GFGSpatialIndex::Load(GFGSpan<const uint8_t> data)
+{
+	Clear();
+
+	uint32_t nodeCount, itemCount;
+	if(data.size() < sizeof(uint32_t) * 2) return false;
+	std::memcpy(&nodeCount, data.data(), sizeof(uint32_t));
+	std::memcpy(&itemCount, data.data() + sizeof(uint32_t), sizeof(uint32_t));
+
+	uint64_t nodeSize = static_cast<uint64_t>(nodeCount) * sizeof(GFGBVHNode);
+	uint64_t itemSize = static_cast<uint64_t>(itemCount) * sizeof(GFGSpatialItem);
+	if(data.size() - sizeof(uint32_t) * 2 < nodeSize + itemSize) return false;
+
+	std::vector<GFGBVHNode> loadedNodes(nodeCount);
+	std::vector<GFGSpatialItem> loadedItems(itemCount);
+	const uint8_t* ptr = data.data() + sizeof(uint32_t) * 2;
+	if(nodeSize != 0) std::memcpy(loadedNodes.data(), ptr, static_cast<size_t>(nodeSize));
+	if(itemSize != 0) std::memcpy(loadedItems.data(), ptr + nodeSize, static_cast<size_t>(itemSize));
+
+	// Children should come after their parents (no cycles)
+	// and leaves should be in item range
+	for(uint32_t i = 0; i < nodeCount; i++)
+	{
+		const GFGBVHNode& node = loadedNodes[i];
+		bool validNode = (node.count == 0)
+							? (i + 1 < node.first && node.first < nodeCount)
+							: (node.first <= itemCount && itemCount - node.first >= node.count);
+		if(!validNode) return false;
+	}
+
+	nodes = std::move(loadedNodes);
+	items = std::move(loadedItems);
+	return true;
+}
+
+void GFGSpatialIndex::Clear()
+{
+	nodes.clear();
+	items.clear();
+}
+
+void GFGSpatialIndex::Query(std::vector<GFGSpatialItem>& result, const GFGAABB& aabb) const
+{
+	Traverse(result, Nodes(), Items(), aabb);
+}
+
+void GFGSpatialIndex::Query(std::vector<GFGSpatialItem>& result, const GFGFrustum& frustum) const
+{
+	Traverse(result, Nodes(), Items(), frustum);
+}
+
+GFGSpan<const GFGBVHNode> GFGSpatialIndex::Nodes() const
+{
+	return nodes;
+}
+
+GFGSpan<const GFGSpatialItem> GFGSpatialIndex::Items() const
+{
+	return items;
+}
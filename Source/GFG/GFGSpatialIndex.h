@@ -0,0 +1,93 @@
+/**
+
+GFGSpatialItem Struct
+GFGBVHNode Struct
+GFGFrustum Struct
+GFGSpatialIndex Class
+
+Bounding volume hierarchy over the world space bounds of the scene nodes
+that reference a mesh. World bounds are calculated from the object space mesh
+AABB and the node hierarchy transforms (scale, rotate (X then Y then Z), translate).
+
+Index is stored in the header as GFGExtensionTag::SPATIAL_INDEX extension
+(GFGFileExporter::EnableSpatialIndex) and fetched with GFGFileLoader::SpatialIndex.
+Queries return the node and mesh indices that intersect a box or a frustum,
+so only those meshes need to be loaded.
+
+Serialized Layout
+	uint32_t		nodeCount;
+	uint32_t		itemCount;
+	GFGBVHNode		nodes[nodeCount];	// Depth first, root is the first node
+	GFGSpatialItem	items[itemCount];
+
+For License refer to:
+https://github.com/yalcinerbora/GFGFileFormat/blob/master/LICENSE
+*/
+
+#ifndef __GFG_SPATIALINDEX_H__
+#define __GFG_SPATIALINDEX_H__
+
+#include <vector>
+#include "GFGHeader.h"
+#include "GFGSpan.h"
+
+struct GFGSpatialItem
+{
+	GFGAABB		aabb;				// World space bounds of the node's mesh
+	uint32_t	nodeIndex;			// Scene hierarchy node
+	uint32_t	meshIndex;			// Mesh of the node
+};
+
+struct GFGBVHNode
+{
+	GFGAABB		aabb;				// World space bounds of the subtree
+	uint32_t	first;				// Leaf: first item, Internal: right child (left child is the next node)
+	uint32_t	count;				// Leaf: item count, Internal: zero
+};
+
+// Planes are {a, b, c, d} where ax + by + cz + d >= 0 is inside
+struct GFGFrustum
+{
+	float		planes[6][4];
+};
+
+static_assert(sizeof(GFGSpatialItem) == sizeof(float) * 6 + sizeof(uint32_t) * 2, "Spatial Item Size Mismatch");
+static_assert(sizeof(GFGBVHNode) == sizeof(float) * 6 + sizeof(uint32_t) * 2, "BVH Node Size Mismatch");
+
+class GFGSpatialIndex
+{
+	private:
+		std::vector<GFGBVHNode>			nodes;
+		std::vector<GFGSpatialItem>		items;
+
+		uint32_t						BuildRecursive(uint32_t first, uint32_t count);
+
+	protected:
+	public:
+		static constexpr uint32_t		LeafSize = 4;
+
+		// Constructors & Destructor
+										GFGSpatialIndex() = default;
+										~GFGSpatialIndex() = default;
+
+		// Creation
+		void							Build(const GFGHeader&);
+		void							Serialize(std::vector<uint8_t>& data) const;
+		// Returns false if the data is corrupted
+		bool							Load(GFGSpan<const uint8_t> data);
+		void							Clear();
+
+		// World space bounds of each node (object space AABB of the mesh transformed
+		// with the node's world transform), nodes without a mesh have empty
+		// (min > max) bounds.
+		static void						WorldBounds(std::vector<GFGAABB>& nodeBounds, const GFGHeader&);
+
+		// Queries (results are appended)
+		void							Query(std::vector<GFGSpatialItem>&, const GFGAABB&) const;
+		void							Query(std::vector<GFGSpatialItem>&, const GFGFrustum&) const;
+
+		// Access
+		GFGSpan<const GFGBVHNode>		Nodes() const;
+		GFGSpan<const GFGSpatialItem>	Items() const;
+};
+#endif //__GFG_SPATIALINDEX_H__
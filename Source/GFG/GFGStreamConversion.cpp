@@ -0,0 +1,572 @@
+#include "GFGConversion.h"
+#include "GFGStridedCopy.h"
+#include "half.hpp"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+	#define GFG_STREAM_X86
+	#include <immintrin.h>
+	#if defined(_MSC_VER) && !defined(__clang__)
+		#include <intrin.h>
+		#define GFG_TARGET_AVX2
+	#else
+		#define GFG_TARGET_AVX2 __attribute__((target("avx2,f16c")))
+	#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+	#define GFG_STREAM_NEON
+	#include <arm_neon.h>
+#endif
+
+// Data types are laid out as families of four (1 to 4 components)
+static_assert(static_cast<uint32_t>(GFGDataType::FLOAT_1) == 4, "GFGDataType layout changed");
+static_assert(static_cast<uint32_t>(GFGDataType::INT8_1) == 16, "GFGDataType layout changed");
+static_assert(static_cast<uint32_t>(GFGDataType::UNORM32_4) == 71, "GFGDataType layout changed");
+
+namespace
+{
+	enum class Scalar
+	{
+		HALF,
+		FLOAT,
+		DOUBLE,
+		INT8,
+		UINT8,
+		INT16,
+		UINT16,
+		INT32,
+		UINT32,
+		INT64,
+		UINT64,
+		NORM8,
+		UNORM8,
+		NORM16,
+		UNORM16,
+		NORM32,
+		UNORM32,
+
+		END,
+		UNSUPPORTED = END
+	};
+	constexpr size_t ScalarCount = static_cast<size_t>(Scalar::END);
+
+	constexpr size_t ScalarByteSize[ScalarCount] =
+	{
+		2, 4, 8,
+		1, 1, 2, 2, 4, 4, 8, 8,
+		1, 1, 2, 2, 4, 4
+	};
+
+	struct StreamType
+	{
+		Scalar		scalar;
+		uint32_t	components;
+	};
+
+	StreamType Classify(GFGDataType type)
+	{
+		// Family order of the GFGDataType (quadruple is not supported)
+		static constexpr Scalar Families[] =
+		{
+			Scalar::HALF, Scalar::FLOAT, Scalar::DOUBLE, Scalar::UNSUPPORTED,
+			Scalar::INT8, Scalar::UINT8, Scalar::INT16, Scalar::UINT16,
+			Scalar::INT32, Scalar::UINT32, Scalar::INT64, Scalar::UINT64,
+			Scalar::NORM8, Scalar::UNORM8, Scalar::NORM16, Scalar::UNORM16,
+			Scalar::NORM32, Scalar::UNORM32
+		};
+
+		if(type == GFGDataType::QUATERNION) return {Scalar::FLOAT, 4};
+
+		uint32_t value = static_cast<uint32_t>(type);
+		if(value > static_cast<uint32_t>(GFGDataType::UNORM32_4)) return {Scalar::UNSUPPORTED, 0};
+		return {Families[value / 4], value % 4 + 1};
+	}
+
+	size_t ElementSize(const StreamType& t)
+	{
+		return ScalarByteSize[static_cast<size_t>(t.scalar)] * t.components;
+	}
+
+	// Kernels convert "count" packed scalars
+	// (source and destination do not need to be aligned)
+	using ConvertKernel = void(*)(uint8_t dst[], const uint8_t src[], size_t count);
+
+	template <class D>
+	void Store(uint8_t dst[], size_t i, D value)
+	{
+		std::memcpy(dst + i * sizeof(D), &value, sizeof(D));
+	}
+
+	template <class S, class D>
+	void CastKernel(uint8_t dst[], const uint8_t src[], size_t count)
+	{
+		for(size_t i = 0; i < count; i++)
+		{
+			S s;
+			std::memcpy(&s, src + i * sizeof(S), sizeof(S));
+			Store(dst, i, static_cast<D>(s));
+		}
+	}
+
+	template <class S, class D>
+	void NormKernel(uint8_t dst[], const uint8_t src[], size_t count)
+	{
+		// 32-bit values do not fit into the float mantissa, divide in double
+		using C = typename std::conditional<(sizeof(S) >= 4), double, D>::type;
+		constexpr C Max = static_cast<C>(std::numeric_limits<S>::max());
+		for(size_t i = 0; i < count; i++)
+		{
+			S s;
+			std::memcpy(&s, src + i * sizeof(S), sizeof(S));
+			Store(dst, i, static_cast<D>(static_cast<C>(s) / Max));
+		}
+	}
+
+	template <class D>
+	void HalfKernel(uint8_t dst[], const uint8_t src[], size_t count)
+	{
+		for(size_t i = 0; i < count; i++)
+		{
+			half_float::half h;
+			std::memcpy(&h, src + i * sizeof(half_float::half), sizeof(half_float::half));
+			Store(dst, i, static_cast<D>(static_cast<float>(h)));
+		}
+	}
+
+	void FloatToHalfKernel(uint8_t dst[], const uint8_t src[], size_t count)
+	{
+		for(size_t i = 0; i < count; i++)
+		{
+			float f;
+			std::memcpy(&f, src + i * sizeof(float), sizeof(float));
+			Store(dst, i, GFGConversions::FloatToHalf(f));
+		}
+	}
+
+	void DoubleToHalfKernel(uint8_t dst[], const uint8_t src[], size_t count)
+	{
+		for(size_t i = 0; i < count; i++)
+		{
+			double d;
+			std::memcpy(&d, src + i * sizeof(double), sizeof(double));
+			Store(dst, i, GFGConversions::DoubleToHalf(d));
+		}
+	}
+
+	// SIMD half packing should be identical to half.hpp, default rounding
+	// of half.hpp truncates (and maps overflow to infinity)
+	// Floats with magnitude >= 65536 (overflow, inf and NaN) are converted
+	// by the scalar kernel
+	#if HALF_ROUND_STYLE == -1
+		#define GFG_SIMD_HALF_PACK
+	#endif
+	constexpr uint32_t HalfOverflowBits = 0x477FFFFF;
+
+	#ifdef GFG_STREAM_X86
+	// AVX2 & F16C kernels (8 floats or 4 doubles per iteration)
+	// remainder is handled by the scalar kernels
+	bool HasAVX2()
+	{
+		#if defined(_MSC_VER) && !defined(__clang__)
+			int info[4];
+			__cpuid(info, 0);
+			if(info[0] < 7) return false;
+			__cpuid(info, 1);
+			bool osxsave = (info[2] & (1 << 27)) != 0;
+			bool f16c = (info[2] & (1 << 29)) != 0;
+			if(!osxsave || !f16c) return false;
+			// OS should save YMM registers
+			if((_xgetbv(0) & 0x6) != 0x6) return false;
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0;
+		#else
+			return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c");
+		#endif
+	}
+
+	GFG_TARGET_AVX2
+	void HalfToFloatAVX2(uint8_t dst[], const uint8_t src[], size_t count)
+	{
+		size_t i = 0;
+		for(; i + 8 <= count; i += 8)
+		{
+			__m128i h = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+			_mm256_storeu_ps(reinterpret_cast<float*>(dst + i * 4), _mm256_cvtph_ps(h));
+		}
+		HalfKernel<float>(dst + i * 4, src + i * 2, count - i);
+	}
+
+	GFG_TARGET_AVX2
+	void HalfToDoubleAVX2(uint8_t dst[], const uint8_t src[], size_t count)
+	{
+		size_t i = 0;
+		for(; i + 4 <= count; i += 4)
+		{
+			__m128i h = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i * 2));
+			__m256d d = _mm256_cvtps_pd(_mm_cvtph_ps(h));
+			_mm256_storeu_pd(reinterpret_cast<double*>(dst + i * 8), d);
+		}
+		HalfKernel<double>(dst + i * 8, src + i * 2, count - i);
+	}
+
+	#ifdef GFG_SIMD_HALF_PACK
+	GFG_TARGET_AVX2
+	void FloatToHalfAVX2(uint8_t dst[], const uint8_t src[], size_t count)
+	{
+		const __m256i absMask = _mm256_set1_epi32(0x7FFFFFFF);
+		const __m256i overflow = _mm256_set1_epi32(static_cast<int>(HalfOverflowBits));
+		size_t i = 0;
+		for(; i + 8 <= count; i += 8)
+		{
+			__m256 f = _mm256_loadu_ps(reinterpret_cast<const float*>(src + i * 4));
+			__m256i special = _mm256_cmpgt_epi32(_mm256_and_si256(_mm256_castps_si256(f), absMask), overflow);
+			if(!_mm256_testz_si256(special, special))
+				FloatToHalfKernel(dst + i * 2, src + i * 4, 8);
+			else
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 2), _mm256_cvtps_ph(f, _MM_FROUND_TO_ZERO));
+		}
+		FloatToHalfKernel(dst + i * 2, src + i * 4, count - i);
+	}
+
+	GFG_TARGET_AVX2
+	void DoubleToHalfAVX2(uint8_t dst[], const uint8_t src[], size_t count)
+	{
+		// Double is rounded to float first (same as DoubleToHalf)
+		const __m128i absMask = _mm_set1_epi32(0x7FFFFFFF);
+		const __m128i overflow = _mm_set1_epi32(static_cast<int>(HalfOverflowBits));
+		size_t i = 0;
+		for(; i + 4 <= count; i += 4)
+		{
+			__m128 f = _mm256_cvtpd_ps(_mm256_loadu_pd(reinterpret_cast<const double*>(src + i * 8)));
+			__m128i special = _mm_cmpgt_epi32(_mm_and_si128(_mm_castps_si128(f), absMask), overflow);
+			if(!_mm_testz_si128(special, special))
+				DoubleToHalfKernel(dst + i * 2, src + i * 8, 4);
+			else
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(dst + i * 2), _mm_cvtps_ph(f, _MM_FROUND_TO_ZERO));
+		}
+		DoubleToHalfKernel(dst + i * 2, src + i * 8, count - i);
+	}
+	#endif
+
+	GFG_TARGET_AVX2
+	void FloatToDoubleAVX2(uint8_t dst[], const uint8_t src[], size_t count)
+	{
+		size_t i = 0;
+		for(; i + 4 <= count; i += 4)
+		{
+			__m128 f = _mm_loadu_ps(reinterpret_cast<const float*>(src + i * 4));
+			_mm256_storeu_pd(reinterpret_cast<double*>(dst + i * 8), _mm256_cvtps_pd(f));
+		}
+		CastKernel<float, double>(dst + i * 8, src + i * 4, count - i);
+	}
+
+	// 8 and 16-bit integers are widened to 32-bit, converted and
+	// optionally divided by the maximum (identical to the scalar division)
+	template <class S>
+	GFG_TARGET_AVX2
+	__m256i Widen8AVX2(const uint8_t src[])
+	{
+		if constexpr(sizeof(S) == 1)
+		{
+			__m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src));
+			return std::is_signed<S>::value ? _mm256_cvtepi8_epi32(v) : _mm256_cvtepu8_epi32(v);
+		}
+		else
+		{
+			__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+			return std::is_signed<S>::value ? _mm256_cvtepi16_epi32(v) : _mm256_cvtepu16_epi32(v);
+		}
+	}
+
+	template <class S, bool Normalize>
+	GFG_TARGET_AVX2
+	void SmallIntToFloatAVX2(uint8_t dst[], const uint8_t src[], size_t count)
+	{
+		const __m256 max = _mm256_set1_ps(static_cast<float>(std::numeric_limits<S>::max()));
+		size_t i = 0;
+		for(; i + 8 <= count; i += 8)
+		{
+			__m256 f = _mm256_cvtepi32_ps(Widen8AVX2<S>(src + i * sizeof(S)));
+			if(Normalize) f = _mm256_div_ps(f, max);
+			_mm256_storeu_ps(reinterpret_cast<float*>(dst + i * 4), f);
+		}
+		if(Normalize)	NormKernel<S, float>(dst + i * 4, src + i * sizeof(S), count - i);
+		else			CastKernel<S, float>(dst + i * 4, src + i * sizeof(S), count - i);
+	}
+	#endif
+
+	#ifdef GFG_STREAM_NEON
+	// NEON kernels (4 floats per iteration)
+	void HalfToFloatNEON(uint8_t dst[], const uint8_t src[], size_t count)
+	{
+		size_t i = 0;
+		for(; i + 4 <= count; i += 4)
+		{
+			float16x4_t h = vreinterpret_f16_u16(vld1_u16(reinterpret_cast<const uint16_t*>(src + i * 2)));
+			vst1q_f32(reinterpret_cast<float*>(dst + i * 4), vcvt_f32_f16(h));
+		}
+		HalfKernel<float>(dst + i * 4, src + i * 2, count - i);
+	}
+
+	void HalfToDoubleNEON(uint8_t dst[], const uint8_t src[], size_t count)
+	{
+		size_t i = 0;
+		for(; i + 4 <= count; i += 4)
+		{
+			float16x4_t h = vreinterpret_f16_u16(vld1_u16(reinterpret_cast<const uint16_t*>(src + i * 2)));
+			float32x4_t f = vcvt_f32_f16(h);
+			vst1q_f64(reinterpret_cast<double*>(dst + i * 8), vcvt_f64_f32(vget_low_f32(f)));
+			vst1q_f64(reinterpret_cast<double*>(dst + i * 8 + 16), vcvt_high_f64_f32(f));
+		}
+		HalfKernel<double>(dst + i * 8, src + i * 2, count - i);
+	}
+
+	#ifdef GFG_SIMD_HALF_PACK
+	// FCVTN rounds to nearest, results that are rounded away from zero
+	// are stepped back (half bits are monotonic in magnitude)
+	bool HasHalfSpecialNEON(float32x4_t f)
+	{
+		uint32x4_t abs = vandq_u32(vreinterpretq_u32_f32(f), vdupq_n_u32(0x7FFFFFFF));
+		return vmaxvq_u32(vcgtq_u32(abs, vdupq_n_u32(HalfOverflowBits))) != 0;
+	}
+
+	uint16x4_t TruncateToHalfNEON(float32x4_t f)
+	{
+		uint16x4_t h = vreinterpret_u16_f16(vcvt_f16_f32(f));
+		uint32x4_t away = vcagtq_f32(vcvt_f32_f16(vreinterpret_f16_u16(h)), f);
+		return vsub_u16(h, vmovn_u32(vshrq_n_u32(away, 31)));
+	}
+
+	void FloatToHalfNEON(uint8_t dst[], const uint8_t src[], size_t count)
+	{
+		size_t i = 0;
+		for(; i + 4 <= count; i += 4)
+		{
+			float32x4_t f = vld1q_f32(reinterpret_cast<const float*>(src + i * 4));
+			if(HasHalfSpecialNEON(f))
+				FloatToHalfKernel(dst + i * 2, src + i * 4, 4);
+			else
+				vst1_u16(reinterpret_cast<uint16_t*>(dst + i * 2), TruncateToHalfNEON(f));
+		}
+		FloatToHalfKernel(dst + i * 2, src + i * 4, count - i);
+	}
+
+	void DoubleToHalfNEON(uint8_t dst[], const uint8_t src[], size_t count)
+	{
+		size_t i = 0;
+		for(; i + 4 <= count; i += 4)
+		{
+			const double* d = reinterpret_cast<const double*>(src + i * 8);
+			float32x4_t f = vcvt_high_f32_f64(vcvt_f32_f64(vld1q_f64(d)), vld1q_f64(d + 2));
+			if(HasHalfSpecialNEON(f))
+				DoubleToHalfKernel(dst + i * 2, src + i * 8, 4);
+			else
+				vst1_u16(reinterpret_cast<uint16_t*>(dst + i * 2), TruncateToHalfNEON(f));
+		}
+		DoubleToHalfKernel(dst + i * 2, src + i * 8, count - i);
+	}
+	#endif
+
+	template <class S, bool Normalize>
+	void Int16ToFloatNEON(uint8_t dst[], const uint8_t src[], size_t count)
+	{
+		const float32x4_t max = vdupq_n_f32(static_cast<float>(std::numeric_limits<S>::max()));
+		size_t i = 0;
+		for(; i + 4 <= count; i += 4)
+		{
+			float32x4_t f;
+			if constexpr(std::is_signed<S>::value)
+				f = vcvtq_f32_s32(vmovl_s16(vld1_s16(reinterpret_cast<const int16_t*>(src + i * 2))));
+			else
+				f = vcvtq_f32_u32(vmovl_u16(vld1_u16(reinterpret_cast<const uint16_t*>(src + i * 2))));
+			if(Normalize) f = vdivq_f32(f, max);
+			vst1q_f32(reinterpret_cast<float*>(dst + i * 4), f);
+		}
+		if(Normalize)	NormKernel<S, float>(dst + i * 4, src + i * 2, count - i);
+		else			CastKernel<S, float>(dst + i * 4, src + i * 2, count - i);
+	}
+	#endif
+
+	struct Kernels
+	{
+		ConvertKernel	toFloat[ScalarCount];
+		ConvertKernel	toDouble[ScalarCount];
+		ConvertKernel	floatToHalf;
+		ConvertKernel	doubleToHalf;
+	};
+
+	template <class D>
+	void ScalarKernels(ConvertKernel kernels[ScalarCount])
+	{
+		kernels[static_cast<size_t>(Scalar::HALF)] = HalfKernel<D>;
+		kernels[static_cast<size_t>(Scalar::FLOAT)] = CastKernel<float, D>;
+		kernels[static_cast<size_t>(Scalar::DOUBLE)] = CastKernel<double, D>;
+		kernels[static_cast<size_t>(Scalar::INT8)] = CastKernel<int8_t, D>;
+		kernels[static_cast<size_t>(Scalar::UINT8)] = CastKernel<uint8_t, D>;
+		kernels[static_cast<size_t>(Scalar::INT16)] = CastKernel<int16_t, D>;
+		kernels[static_cast<size_t>(Scalar::UINT16)] = CastKernel<uint16_t, D>;
+		kernels[static_cast<size_t>(Scalar::INT32)] = CastKernel<int32_t, D>;
+		kernels[static_cast<size_t>(Scalar::UINT32)] = CastKernel<uint32_t, D>;
+		kernels[static_cast<size_t>(Scalar::INT64)] = CastKernel<int64_t, D>;
+		kernels[static_cast<size_t>(Scalar::UINT64)] = CastKernel<uint64_t, D>;
+		kernels[static_cast<size_t>(Scalar::NORM8)] = NormKernel<int8_t, D>;
+		kernels[static_cast<size_t>(Scalar::UNORM8)] = NormKernel<uint8_t, D>;
+		kernels[static_cast<size_t>(Scalar::NORM16)] = NormKernel<int16_t, D>;
+		kernels[static_cast<size_t>(Scalar::UNORM16)] = NormKernel<uint16_t, D>;
+		kernels[static_cast<size_t>(Scalar::NORM32)] = NormKernel<int32_t, D>;
+		kernels[static_cast<size_t>(Scalar::UNORM32)] = NormKernel<uint32_t, D>;
+	}
+
+	Kernels SelectKernels()
+	{
+		Kernels k;
+		ScalarKernels<float>(k.toFloat);
+		ScalarKernels<double>(k.toDouble);
+		k.floatToHalf = FloatToHalfKernel;
+		k.doubleToHalf = DoubleToHalfKernel;
+
+		#if defined(GFG_STREAM_X86)
+		if(HasAVX2())
+		{
+			k.toFloat[static_cast<size_t>(Scalar::HALF)] = HalfToFloatAVX2;
+			k.toFloat[static_cast<size_t>(Scalar::INT8)] = SmallIntToFloatAVX2<int8_t, false>;
+			k.toFloat[static_cast<size_t>(Scalar::UINT8)] = SmallIntToFloatAVX2<uint8_t, false>;
+			k.toFloat[static_cast<size_t>(Scalar::INT16)] = SmallIntToFloatAVX2<int16_t, false>;
+			k.toFloat[static_cast<size_t>(Scalar::UINT16)] = SmallIntToFloatAVX2<uint16_t, false>;
+			k.toFloat[static_cast<size_t>(Scalar::NORM8)] = SmallIntToFloatAVX2<int8_t, true>;
+			k.toFloat[static_cast<size_t>(Scalar::UNORM8)] = SmallIntToFloatAVX2<uint8_t, true>;
+			k.toFloat[static_cast<size_t>(Scalar::NORM16)] = SmallIntToFloatAVX2<int16_t, true>;
+			k.toFloat[static_cast<size_t>(Scalar::UNORM16)] = SmallIntToFloatAVX2<uint16_t, true>;
+			k.toDouble[static_cast<size_t>(Scalar::HALF)] = HalfToDoubleAVX2;
+			k.toDouble[static_cast<size_t>(Scalar::FLOAT)] = FloatToDoubleAVX2;
+			#ifdef GFG_SIMD_HALF_PACK
+			k.floatToHalf = FloatToHalfAVX2;
+			k.doubleToHalf = DoubleToHalfAVX2;
+			#endif
+		}
+		#elif defined(GFG_STREAM_NEON)
+		k.toFloat[static_cast<size_t>(Scalar::HALF)] = HalfToFloatNEON;
+		k.toFloat[static_cast<size_t>(Scalar::INT16)] = Int16ToFloatNEON<int16_t, false>;
+		k.toFloat[static_cast<size_t>(Scalar::UINT16)] = Int16ToFloatNEON<uint16_t, false>;
+		k.toFloat[static_cast<size_t>(Scalar::NORM16)] = Int16ToFloatNEON<int16_t, true>;
+		k.toFloat[static_cast<size_t>(Scalar::UNORM16)] = Int16ToFloatNEON<uint16_t, true>;
+		k.toDouble[static_cast<size_t>(Scalar::HALF)] = HalfToDoubleNEON;
+		#ifdef GFG_SIMD_HALF_PACK
+		k.floatToHalf = FloatToHalfNEON;
+		k.doubleToHalf = DoubleToHalfNEON;
+		#endif
+		#endif
+		return k;
+	}
+
+	const Kernels& ActiveKernels()
+	{
+		static const Kernels kernels = SelectKernels();
+		return kernels;
+	}
+
+	// Elements are converted in blocks that fit in L1
+	// strided sides are gathered/scattered to/from packed block buffers
+	constexpr size_t StreamBlockSize = 256;
+	constexpr size_t MaxElementSize = 4 * sizeof(double);
+}
+
+bool GFGConversions::IsStreamConvertible(GFGDataType dstType, GFGDataType srcType)
+{
+	if(dstType == srcType) return true;
+
+	StreamType dst = Classify(dstType);
+	StreamType src = Classify(srcType);
+	return (src.scalar != Scalar::UNSUPPORTED) &&
+		   (dst.scalar == Scalar::HALF ||
+			dst.scalar == Scalar::FLOAT ||
+			dst.scalar == Scalar::DOUBLE) &&
+		   (dst.components == src.components);
+}
+
+bool GFGConversions::ConvertStream(uint8_t dst[], size_t dstStride, GFGDataType dstType,
+								   const uint8_t src[], size_t srcStride, GFGDataType srcType,
+								   size_t count)
+{
+	if(!IsStreamConvertible(dstType, srcType)) return false;
+	if(count == 0) return true;
+
+	StreamType dstT = Classify(dstType);
+	StreamType srcT = Classify(srcType);
+	if(dstType == srcType || dstT.scalar == srcT.scalar)
+	{
+		size_t elementSize = GFGDataTypeByteSize[static_cast<uint32_t>(srcType)];
+		GFGStridedCopy(dst, dstStride, src, srcStride, elementSize, count);
+		return true;
+	}
+
+	const Kernels& kernels = ActiveKernels();
+	size_t srcElement = ElementSize(srcT);
+	size_t dstElement = ElementSize(dstT);
+	size_t components = dstT.components;
+
+	alignas(32) uint8_t srcBlock[StreamBlockSize * MaxElementSize];
+	alignas(32) uint8_t floatBlock[StreamBlockSize * MaxElementSize];
+	alignas(32) uint8_t dstBlock[StreamBlockSize * MaxElementSize];
+	for(size_t i = 0; i < count; i += StreamBlockSize)
+	{
+		size_t n = std::min(StreamBlockSize, count - i);
+		size_t scalarCount = n * components;
+
+		const uint8_t* s = src + i * srcStride;
+		if(srcStride != srcElement)
+		{
+			GFGStridedCopy(srcBlock, srcElement, s, srcStride, srcElement, n);
+			s = srcBlock;
+		}
+		uint8_t* d = dst + i * dstStride;
+		uint8_t* out = (dstStride == dstElement) ? d : dstBlock;
+
+		size_t srcScalar = static_cast<size_t>(srcT.scalar);
+		switch(dstT.scalar)
+		{
+			case Scalar::FLOAT:
+				kernels.toFloat[srcScalar](out, s, scalarCount);
+				break;
+			case Scalar::DOUBLE:
+				kernels.toDouble[srcScalar](out, s, scalarCount);
+				break;
+			case Scalar::HALF:
+				if(srcT.scalar == Scalar::DOUBLE)
+				{
+					// Same rounding of the DoubleToHalf (double to float to half)
+					kernels.doubleToHalf(out, s, scalarCount);
+					break;
+				}
+				kernels.toFloat[srcScalar](floatBlock, s, scalarCount);
+				kernels.floatToHalf(out, floatBlock, scalarCount);
+				break;
+			default:
+				return false;
+		}
+		if(out != d) GFGStridedCopy(d, dstStride, dstBlock, dstElement, dstElement, n);
+	}
+	return true;
+}
+
+void GFGConversions::FloatToHalfStream(uint8_t dst[], const float src[], size_t count)
+{
+	ActiveKernels().floatToHalf(dst, reinterpret_cast<const uint8_t*>(src), count);
+}
+
+void GFGConversions::DoubleToHalfStream(uint8_t dst[], const double src[], size_t count)
+{
+	ActiveKernels().doubleToHalf(dst, reinterpret_cast<const uint8_t*>(src), count);
+}
+
+void GFGConversions::HalfToFloatStream(float dst[], const uint8_t src[], size_t count)
+{
+	ActiveKernels().toFloat[static_cast<size_t>(Scalar::HALF)](reinterpret_cast<uint8_t*>(dst), src, count);
+}
+
+void GFGConversions::HalfToDoubleStream(double dst[], const uint8_t src[], size_t count)
+{
+	ActiveKernels().toDouble[static_cast<size_t>(Scalar::HALF)](reinterpret_cast<uint8_t*>(dst), src, count);
+}
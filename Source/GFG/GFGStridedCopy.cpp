@@ -0,0 +1,89 @@
+#include "GFGStridedCopy.h"
+#include <cstring>
+
+// Constant size memcpy is compiled to plain (unaligned) loads and stores
+template <size_t N>
+static void CopyFixed(uint8_t dst[], size_t dstStride,
+					  const uint8_t src[], size_t srcStride,
+					  size_t count)
+{
+	for(size_t i = 0; i < count; i++)
+	{
+		std::memcpy(dst, src, N);
+		dst += dstStride;
+		src += srcStride;
+	}
+}
+
+// Packed destination, element smaller than 16 bytes and source stride >= 16
+// Each element is copied with a single 16 byte move; extra bytes that are
+// written to the destination are overwritten by the following elements.
+// Last elements are copied exactly (neither source nor destination overruns)
+static void CopyOverlapped16(uint8_t dst[], const uint8_t src[], size_t srcStride,
+							 size_t elementSize, size_t count)
+{
+	// Elements that have 16 bytes of destination space after their start
+	size_t wideCount = (count * elementSize >= 16)
+						? (count * elementSize - 16) / elementSize + 1
+						: 0;
+	// Last element source may not have 16 readable bytes
+	wideCount = (wideCount < count) ? wideCount : count - 1;
+
+	size_t i = 0;
+	for(; i < wideCount; i++)
+	{
+		uint8_t element[16];
+		std::memcpy(element, src, 16);
+		std::memcpy(dst, element, 16);
+		dst += elementSize;
+		src += srcStride;
+	}
+	for(; i < count; i++)
+	{
+		std::memcpy(dst, src, elementSize);
+		dst += elementSize;
+		src += srcStride;
+	}
+}
+
+void GFGStridedCopy(uint8_t dst[], size_t dstStride,
+					const uint8_t src[], size_t srcStride,
+					size_t elementSize, size_t count)
+{
+	if(count == 0 || elementSize == 0) return;
+
+	// Both sides are packed
+	if(dstStride == elementSize && srcStride == elementSize)
+	{
+		std::memcpy(dst, src, elementSize * count);
+		return;
+	}
+
+	// Gather to packed array
+	if(dstStride == elementSize && elementSize < 16 && srcStride >= 16)
+	{
+		CopyOverlapped16(dst, src, srcStride, elementSize, count);
+		return;
+	}
+
+	switch(elementSize)
+	{
+		case 1:		CopyFixed<1>(dst, dstStride, src, srcStride, count); return;
+		case 2:		CopyFixed<2>(dst, dstStride, src, srcStride, count); return;
+		case 4:		CopyFixed<4>(dst, dstStride, src, srcStride, count); return;
+		case 6:		CopyFixed<6>(dst, dstStride, src, srcStride, count); return;
+		case 8:		CopyFixed<8>(dst, dstStride, src, srcStride, count); return;
+		case 12:	CopyFixed<12>(dst, dstStride, src, srcStride, count); return;
+		case 16:	CopyFixed<16>(dst, dstStride, src, srcStride, count); return;
+		default:
+		{
+			for(size_t i = 0; i < count; i++)
+			{
+				std::memcpy(dst, src, elementSize);
+				dst += dstStride;
+				src += srcStride;
+			}
+			return;
+		}
+	}
+}
@@ -0,0 +1,27 @@
+/**
+
+GFGStridedCopy Function
+
+Copies "count" elements of "elementSize" bytes from a strided source to a
+strided destination. Used to extract (gather) a single vertex component
+from an interleaved group into a packed array and the reverse (scatter).
+
+Common element sizes use fixed size copies (compiled to single loads/stores)
+and packed destinations with source stride >= 16 use overlapping
+16 byte moves (single SIMD load/store per element).
+
+For License refer to:
+https://github.com/yalcinerbora/GFGFileFormat/blob/master/LICENSE
+*/
+
+#ifndef __GFG_STRIDEDCOPY_H__
+#define __GFG_STRIDEDCOPY_H__
+
+#include <cstddef>
+#include <cstdint>
+
+void GFGStridedCopy(uint8_t dst[], size_t dstStride,
+					const uint8_t src[], size_t srcStride,
+					size_t elementSize, size_t count);
+
+#endif //__GFG_STRIDEDCOPY_H__
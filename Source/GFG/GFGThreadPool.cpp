@@ -0,0 +1,127 @@
+#include "GFGThreadPool.h"
+#include <cassert>
+
+// Worker identification (to push to own queue)
+static thread_local const GFGThreadPool*	currentPool = nullptr;
+static thread_local uint32_t				currentWorker = 0;
+
+GFGThreadPool::GFGThreadPool(uint32_t threadCount)
+	: pendingCount(0)
+	, nextQueue(0)
+	, stop(false)
+{
+	if(threadCount == 0) threadCount = 1;
+	for(uint32_t i = 0; i < threadCount; i++)
+		queues.emplace_back(std::make_unique<WorkQueue>());
+	for(uint32_t i = 0; i < threadCount; i++)
+		threads.emplace_back(&GFGThreadPool::Worker, this, i);
+}
+
+GFGThreadPool::~GFGThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		stop = true;
+	}
+	sleepCondition.notify_all();
+	for(std::thread& t : threads) t.join();
+}
+
+bool GFGThreadPool::TryPop(uint32_t queueIndex, Task& task)
+{
+	WorkQueue& q = *queues[queueIndex];
+	std::lock_guard<std::mutex> lock(q.mutex);
+	if(q.tasks.empty()) return false;
+	task = std::move(q.tasks.back());
+	q.tasks.pop_back();
+	return true;
+}
+
+bool GFGThreadPool::TrySteal(uint32_t queueIndex, Task& task)
+{
+	// Queue is locked (not tried) so that a contended queue is not seen as empty
+	WorkQueue& q = *queues[queueIndex];
+	std::lock_guard<std::mutex> lock(q.mutex);
+	if(q.tasks.empty()) return false;
+	task = std::move(q.tasks.front());
+	q.tasks.pop_front();
+	return true;
+}
+
+void GFGThreadPool::Worker(uint32_t workerIndex)
+{
+	currentPool = this;
+	currentWorker = workerIndex;
+
+	uint32_t queueCount = static_cast<uint32_t>(queues.size());
+	Task task;
+	while(true)
+	{
+		// Own queue first then try to steal from others
+		bool found = TryPop(workerIndex, task);
+		for(uint32_t i = 1; !found && i < queueCount; i++)
+			found = TrySteal((workerIndex + i) % queueCount, task);
+
+		if(found)
+		{
+			pendingCount--;
+			task();
+			task = nullptr;
+			continue;
+		}
+
+		// Nothing to do, sleep until a task is submitted
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		if(stop && pendingCount == 0) break;
+		sleepCondition.wait(lock, [&]()
+		{
+			return stop || pendingCount > 0;
+		});
+		if(stop && pendingCount == 0) break;
+	}
+	currentPool = nullptr;
+}
+
+void GFGThreadPool::Submit(Task task)
+{
+	uint32_t queueIndex;
+	if(currentPool == this)
+		queueIndex = currentWorker;
+	else
+		queueIndex = nextQueue++ % static_cast<uint32_t>(queues.size());
+
+	{
+		// Counted before the task is visible so that a worker that takes
+		// the task can not decrement first (count would wrap).
+		// Incremented under the lock so that sleeping workers do not miss it
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		pendingCount++;
+	}
+	{
+		WorkQueue& q = *queues[queueIndex];
+		std::lock_guard<std::mutex> lock(q.mutex);
+		q.tasks.emplace_back(std::move(task));
+	}
+	sleepCondition.notify_one();
+}
+
+bool GFGThreadPool::RunPendingTask()
+{
+	// Own queue first if this is a worker
+	uint32_t queueCount = static_cast<uint32_t>(queues.size());
+	uint32_t start = (currentPool == this) ? currentWorker : 0;
+	Task task;
+	bool found = (currentPool == this) && TryPop(start, task);
+	for(uint32_t i = 0; !found && i < queueCount; i++)
+		found = TrySteal((start + i) % queueCount, task);
+	if(!found) return false;
+
+	pendingCount--;
+	task();
+	return true;
+}
+
+uint32_t GFGThreadPool::ThreadCount() const
+{
+	return static_cast<uint32_t>(threads.size());
+}
\ No newline at end of file
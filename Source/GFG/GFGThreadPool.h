@@ -0,0 +1,72 @@
+/**
+
+GFGThreadPool Class
+
+Simple work stealing thread pool.
+
+Each worker has its own task queue. Tasks submitted from a worker go to
+the worker's own queue (executed LIFO for locality), tasks submitted
+from outside are distributed round-robin. Idle workers steal from the
+front of other workers' queues.
+
+Used by the GFGParallelLoader.
+
+For License refer to:
+https://github.com/yalcinerbora/GFGFileFormat/blob/master/LICENSE
+*/
+
+#ifndef __GFG_THREADPOOL_H__
+#define __GFG_THREADPOOL_H__
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class GFGThreadPool
+{
+	public:
+		using Task = std::function<void()>;
+
+	private:
+		struct WorkQueue
+		{
+			std::mutex			mutex;
+			std::deque<Task>	tasks;
+		};
+
+		std::vector<std::unique_ptr<WorkQueue>>	queues;
+		std::vector<std::thread>				threads;
+
+		// Sleeping
+		std::mutex								sleepMutex;
+		std::condition_variable					sleepCondition;
+		std::atomic<size_t>						pendingCount;
+		std::atomic<uint32_t>					nextQueue;
+		bool									stop;
+
+		bool									TryPop(uint32_t queueIndex, Task&);
+		bool									TrySteal(uint32_t queueIndex, Task&);
+		void									Worker(uint32_t workerIndex);
+
+	protected:
+	public:
+		// Constructors & Destructor
+												GFGThreadPool(uint32_t threadCount = std::thread::hardware_concurrency());
+												GFGThreadPool(const GFGThreadPool&) = delete;
+		GFGThreadPool&							operator=(const GFGThreadPool&) = delete;
+												~GFGThreadPool();
+
+		void									Submit(Task);
+		// Runs a single queued task on the calling thread, returns false if
+		// there is none (used to wait inside a task without blocking a worker)
+		bool									RunPendingTask();
+		uint32_t								ThreadCount() const;
+};
+
+#endif //__GFG_THREADPOOL_H__
\ No newline at end of file
@@ -1,7 +1,181 @@
 #include "GFGVertexElementTypes.h"
 #include "GFGConversion.h"
+#include "GFGStridedCopy.h"
+#include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <limits>
+#include <type_traits>
+
+namespace
+{
+	// Bulk conversions work on blocks of elements, strided sides are
+	// gathered/scattered to/from packed blocks so that inner loops are packed
+	constexpr size_t BulkBlockSize = 64;
+	constexpr size_t MaxComponents = 16;
+
+	// Data types are laid out as families of four (1 to 4 components)
+	// (only valid for the types up to UNORM32_4)
+	uint32_t Components(GFGDataType type)
+	{
+		return static_cast<uint32_t>(type) % 4 + 1;
+	}
+
+	GFGDataType WithComponents(GFGDataType type, uint32_t components)
+	{
+		return static_cast<GFGDataType>(static_cast<uint32_t>(type) / 4 * 4 + components - 1);
+	}
+
+	uint8_t* ComponentData(uint8_t vertexData[], const GFGVertexComponent& component)
+	{
+		return vertexData + static_cast<size_t>(component.startOffset + component.internalOffset);
+	}
+
+	const uint8_t* ComponentData(const uint8_t vertexData[], const GFGVertexComponent& component)
+	{
+		return vertexData + static_cast<size_t>(component.startOffset + component.internalOffset);
+	}
+
+	size_t ComponentStride(const GFGVertexComponent& component)
+	{
+		return static_cast<size_t>(GFGComponentStride(component));
+	}
+
+	// Half, float, double and (u)norm types (to doubles only) are stream convertible
+	bool DoublesToStream(uint8_t data[], size_t dataStride, GFGDataType type,
+						 const double src[], size_t srcStride, size_t count)
+	{
+		GFGDataType srcType = WithComponents(GFGDataType::DOUBLE_1, Components(type));
+		return GFGConversions::ConvertStream(data, dataStride, type,
+											 reinterpret_cast<const uint8_t*>(src),
+											 srcStride * sizeof(double), srcType, count);
+	}
+
+	bool StreamToDoubles(double dst[], size_t dstStride,
+						 const uint8_t data[], size_t dataStride, GFGDataType type,
+						 size_t count)
+	{
+		GFGDataType dstType = WithComponents(GFGDataType::DOUBLE_1, Components(type));
+		return GFGConversions::ConvertStream(reinterpret_cast<uint8_t*>(dst),
+											 dstStride * sizeof(double), dstType,
+											 data, dataStride, type, count);
+	}
+
+	// Packed Scalar Conversions (same as the scalar conversions of GFGConversions)
+	template <class T>
+	void DoublesToNorm(T out[], const double in[], size_t count)
+	{
+		constexpr double Min = std::is_signed<T>::value ? -1.0 : 0.0;
+		constexpr double Max = static_cast<double>(std::numeric_limits<T>::max());
+		for(size_t i = 0; i < count; i++)
+		{
+			double clamped = in[i] <= Min ? Min : in[i] >= 1.0 ? 1.0 : in[i];
+			out[i] = static_cast<T>(clamped * Max);
+		}
+	}
+
+	template <class T>
+	void NormToDoubles(double out[], const T in[], size_t count)
+	{
+		constexpr double Max = static_cast<double>(std::numeric_limits<T>::max());
+		for(size_t i = 0; i < count; i++)
+			out[i] = static_cast<double>(in[i]) / Max;
+	}
+
+	template <class D, class S>
+	void Cast(D out[], const S in[], size_t count)
+	{
+		for(size_t i = 0; i < count; i++)
+			out[i] = static_cast<D>(in[i]);
+	}
+
+	// Converts "count" elements of "components" values to the vertex data
+	// "convert" runs on packed blocks
+	template <class T, class V>
+	void BlockToData(uint8_t data[], size_t dataStride,
+					 const V src[], size_t srcStride,
+					 size_t components, size_t count,
+					 void(*convert)(T[], const V[], size_t))
+	{
+		assert(components <= MaxComponents);
+		V srcBlock[BulkBlockSize * MaxComponents];
+		T dstBlock[BulkBlockSize * MaxComponents];
+		size_t srcElement = components * sizeof(V);
+		size_t dstElement = components * sizeof(T);
+		for(size_t i = 0; i < count; i += BulkBlockSize)
+		{
+			size_t n = std::min(BulkBlockSize, count - i);
+			const V* s = src + i * srcStride;
+			if(srcStride != components)
+			{
+				GFGStridedCopy(reinterpret_cast<uint8_t*>(srcBlock), srcElement,
+							   reinterpret_cast<const uint8_t*>(s), srcStride * sizeof(V),
+							   srcElement, n);
+				s = srcBlock;
+			}
+			convert(dstBlock, s, n * components);
+			GFGStridedCopy(data + i * dataStride, dataStride,
+						   reinterpret_cast<const uint8_t*>(dstBlock), dstElement,
+						   dstElement, n);
+		}
+	}
+
+	template <class T, class V>
+	void DataToBlock(V dst[], size_t dstStride,
+					 const uint8_t data[], size_t dataStride,
+					 size_t components, size_t count,
+					 void(*convert)(V[], const T[], size_t))
+	{
+		assert(components <= MaxComponents);
+		T srcBlock[BulkBlockSize * MaxComponents];
+		V dstBlock[BulkBlockSize * MaxComponents];
+		size_t srcElement = components * sizeof(T);
+		size_t dstElement = components * sizeof(V);
+		for(size_t i = 0; i < count; i += BulkBlockSize)
+		{
+			size_t n = std::min(BulkBlockSize, count - i);
+			GFGStridedCopy(reinterpret_cast<uint8_t*>(srcBlock), srcElement,
+						   data + i * dataStride, dataStride,
+						   srcElement, n);
+			V* d = (dstStride == components) ? dst + i * dstStride : dstBlock;
+			convert(d, srcBlock, n * components);
+			if(d == dstBlock)
+				GFGStridedCopy(reinterpret_cast<uint8_t*>(dst + i * dstStride), dstStride * sizeof(V),
+							   reinterpret_cast<const uint8_t*>(dstBlock), dstElement,
+							   dstElement, n);
+		}
+	}
+
+	// Packed (multi component) types are converted per element
+	template <class V, class Func>
+	void PackElements(uint8_t data[], size_t dataStride,
+					  const V src[], size_t srcStride,
+					  size_t components, size_t count, Func pack)
+	{
+		for(size_t i = 0; i < count; i++)
+		{
+			V expand[4] = {};
+			std::memcpy(expand, src + i * srcStride, sizeof(V) * components);
+			uint32_t packed = pack(expand);
+			std::memcpy(data + i * dataStride, &packed, sizeof(uint32_t));
+		}
+	}
+
+	template <class V, class Func>
+	void UnpackElements(V dst[], size_t dstStride,
+						const uint8_t data[], size_t dataStride,
+						size_t components, size_t count, Func unpack)
+	{
+		for(size_t i = 0; i < count; i++)
+		{
+			uint32_t packed;
+			V expand[4] = {};
+			std::memcpy(&packed, data + i * dataStride, sizeof(uint32_t));
+			unpack(expand, packed);
+			std::memcpy(dst + i * dstStride, expand, sizeof(V) * components);
+		}
+	}
+}
 
 bool GFGPosition::IsCompatible(GFGDataType t)
 {
@@ -68,6 +242,43 @@ bool GFGPosition::UnConvertData(double pos[3], size_t dataSize,
 	return true;
 }
 
+bool GFGPosition::ConvertData(uint8_t vertexData[], const GFGVertexComponent& component,
+							  const double pos[], size_t posStride, size_t count)
+{
+	uint8_t* data = ComponentData(vertexData, component);
+	switch(component.dataType)
+	{
+		case GFGDataType::HALF_3:
+		case GFGDataType::FLOAT_3:
+		case GFGDataType::DOUBLE_3:
+			return DoublesToStream(data, ComponentStride(component), component.dataType,
+								   pos, posStride, count);
+		case GFGDataType::QUADRUPLE_3:
+			return false;
+		default:
+			return false;
+	}
+}
+
+bool GFGPosition::UnConvertData(double pos[], size_t posStride,
+								const uint8_t vertexData[], const GFGVertexComponent& component,
+								size_t count)
+{
+	const uint8_t* data = ComponentData(vertexData, component);
+	switch(component.dataType)
+	{
+		case GFGDataType::HALF_3:
+		case GFGDataType::FLOAT_3:
+		case GFGDataType::DOUBLE_3:
+			return StreamToDoubles(pos, posStride, data, ComponentStride(component),
+								   component.dataType, count);
+		case GFGDataType::QUADRUPLE_3:
+			return false;
+		default:
+			return false;
+	}
+}
+
 bool GFGNormal::IsCompatible(GFGDataType t)
 {
 	switch(t)
@@ -253,6 +464,91 @@ bool GFGNormal::UnConvertData(double normal[3], size_t dataSize,
 	return true;
 }
 
+bool GFGNormal::ConvertData(uint8_t vertexData[], const GFGVertexComponent& component,
+							const double normal[], size_t normalStride, size_t count)
+{
+	uint8_t* data = ComponentData(vertexData, component);
+	size_t stride = ComponentStride(component);
+	GFGDataType type = component.dataType;
+	switch(type)
+	{
+		case GFGDataType::HALF_2:
+		case GFGDataType::HALF_3:
+		case GFGDataType::FLOAT_2:
+		case GFGDataType::FLOAT_3:
+		case GFGDataType::DOUBLE_2:
+		case GFGDataType::DOUBLE_3:
+			return DoublesToStream(data, stride, type, normal, normalStride, count);
+		case GFGDataType::QUADRUPLE_2:
+		case GFGDataType::QUADRUPLE_3:
+		case GFGDataType::QUADRUPLE_4:
+			return false;
+		case GFGDataType::NORM8_2:
+		case GFGDataType::NORM8_3:
+			BlockToData(data, stride, normal, normalStride, Components(type), count, DoublesToNorm<int8_t>);
+			break;
+		case GFGDataType::NORM16_2:
+		case GFGDataType::NORM16_3:
+			BlockToData(data, stride, normal, normalStride, Components(type), count, DoublesToNorm<int16_t>);
+			break;
+		case GFGDataType::NORM32_2:
+		case GFGDataType::NORM32_3:
+			BlockToData(data, stride, normal, normalStride, Components(type), count, DoublesToNorm<int32_t>);
+			break;
+		case GFGDataType::NORM_2_10_10_10:
+			PackElements(data, stride, normal, normalStride, 3, count,
+						 GFGConversions::DoublesToInt2_10_10_10);
+			break;
+		case GFGDataType::CUSTOM_1_15N_16N:
+			PackElements(data, stride, normal, normalStride, 3, count,
+						 GFGConversions::DoublesToCustom_1_15N_16N);
+			break;
+		default:
+			return false;
+	}
+	return true;
+}
+
+bool GFGNormal::UnConvertData(double normal[], size_t normalStride,
+							  const uint8_t vertexData[], const GFGVertexComponent& component,
+							  size_t count)
+{
+	const uint8_t* data = ComponentData(vertexData, component);
+	size_t stride = ComponentStride(component);
+	GFGDataType type = component.dataType;
+	switch(type)
+	{
+		case GFGDataType::HALF_2:
+		case GFGDataType::HALF_3:
+		case GFGDataType::FLOAT_2:
+		case GFGDataType::FLOAT_3:
+		case GFGDataType::DOUBLE_2:
+		case GFGDataType::DOUBLE_3:
+		case GFGDataType::NORM8_2:
+		case GFGDataType::NORM8_3:
+		case GFGDataType::NORM16_2:
+		case GFGDataType::NORM16_3:
+		case GFGDataType::NORM32_2:
+		case GFGDataType::NORM32_3:
+			return StreamToDoubles(normal, normalStride, data, stride, type, count);
+		case GFGDataType::QUADRUPLE_2:
+		case GFGDataType::QUADRUPLE_3:
+		case GFGDataType::QUADRUPLE_4:
+			return false;
+		case GFGDataType::NORM_2_10_10_10:
+			UnpackElements(normal, normalStride, data, stride, 3, count,
+						   GFGConversions::Int2_10_10_10ToDoubles);
+			break;
+		case GFGDataType::CUSTOM_1_15N_16N:
+			UnpackElements(normal, normalStride, data, stride, 3, count,
+						   GFGConversions::Custom_1_15N_16NToDoubles);
+			break;
+		default:
+			return false;
+	}
+	return true;
+}
+
 bool GFGTangent::IsCompatible(GFGDataType t)
 {
 	return GFGNormal::IsCompatible(t);
@@ -296,6 +592,28 @@ bool GFGTangent::ConvertData(uint8_t data[], size_t dataSize,
 	return true;
 }
 
+bool GFGTangent::ConvertData(uint8_t vertexData[], const GFGVertexComponent& component,
+							 const double tangent[], size_t tangentStride, size_t count,
+							 const double normal[],
+							 const double bitangent[])
+{
+	if(component.dataType != GFGDataType::CUSTOM_TANG_H_2N)
+		return GFGNormal::ConvertData(vertexData, component, tangent, tangentStride, count);
+
+	if(normal == nullptr || bitangent == nullptr) return false;
+	uint8_t* data = ComponentData(vertexData, component);
+	size_t stride = ComponentStride(component);
+	for(size_t i = 0; i < count; i++)
+	{
+		uint32_t result[3];
+		size_t offset = i * tangentStride;
+		GFGConversions::DoublesToCustom_Tang_H_2N(result, normal + offset,
+												  tangent + offset, bitangent + offset);
+		std::memcpy(data + i * stride, result, sizeof(uint32_t) * 3);
+	}
+	return true;
+}
+
 bool GFGBinormal::IsCompatible(GFGDataType t)
 {
 	return GFGNormal::IsCompatible(t);
@@ -333,6 +651,13 @@ bool GFGBinormal::ConvertData(uint8_t data[], size_t dataSize,
 	}
 }
 
+bool GFGBinormal::ConvertData(uint8_t vertexData[], const GFGVertexComponent& component,
+							  const double bitangent[], size_t bitangentStride, size_t count)
+{
+	if(component.dataType == GFGDataType::CUSTOM_TANG_H_2N) return false;
+	return GFGNormal::ConvertData(vertexData, component, bitangent, bitangentStride, count);
+}
+
 bool GFGUV::IsCompatible(GFGDataType t)
 {
 	switch(t)
@@ -484,6 +809,87 @@ bool GFGUV::UnConvertData(double uv[2], size_t dataSize,
 	return true;
 }
 
+bool GFGUV::ConvertData(uint8_t vertexData[], const GFGVertexComponent& component,
+						const double uv[], size_t uvStride, size_t count)
+{
+	uint8_t* data = ComponentData(vertexData, component);
+	size_t stride = ComponentStride(component);
+	GFGDataType type = component.dataType;
+	switch(type)
+	{
+		case GFGDataType::HALF_2:
+		case GFGDataType::FLOAT_2:
+		case GFGDataType::DOUBLE_2:
+			return DoublesToStream(data, stride, type, uv, uvStride, count);
+		case GFGDataType::QUADRUPLE_2:
+			return false;
+		case GFGDataType::NORM8_2:
+			BlockToData(data, stride, uv, uvStride, 2, count, DoublesToNorm<int8_t>);
+			break;
+		case GFGDataType::NORM16_2:
+			BlockToData(data, stride, uv, uvStride, 2, count, DoublesToNorm<int16_t>);
+			break;
+		case GFGDataType::NORM32_2:
+			BlockToData(data, stride, uv, uvStride, 2, count, DoublesToNorm<int32_t>);
+			break;
+		case GFGDataType::UNORM8_2:
+			BlockToData(data, stride, uv, uvStride, 2, count, DoublesToNorm<uint8_t>);
+			break;
+		case GFGDataType::UNORM16_2:
+			BlockToData(data, stride, uv, uvStride, 2, count, DoublesToNorm<uint16_t>);
+			break;
+		case GFGDataType::UNORM32_2:
+			BlockToData(data, stride, uv, uvStride, 2, count, DoublesToNorm<uint32_t>);
+			break;
+		case GFGDataType::NORM_2_10_10_10:
+			PackElements(data, stride, uv, uvStride, 2, count,
+						 GFGConversions::DoublesToInt2_10_10_10);
+			break;
+		case GFGDataType::UNORM_2_10_10_10:
+			PackElements(data, stride, uv, uvStride, 2, count,
+						 GFGConversions::DoublesToUInt2_10_10_10);
+			break;
+		default:
+			return false;
+	}
+	return true;
+}
+
+bool GFGUV::UnConvertData(double uv[], size_t uvStride,
+						  const uint8_t vertexData[], const GFGVertexComponent& component,
+						  size_t count)
+{
+	const uint8_t* data = ComponentData(vertexData, component);
+	size_t stride = ComponentStride(component);
+	GFGDataType type = component.dataType;
+	switch(type)
+	{
+		case GFGDataType::HALF_2:
+		case GFGDataType::FLOAT_2:
+		case GFGDataType::DOUBLE_2:
+		case GFGDataType::NORM8_2:
+		case GFGDataType::NORM16_2:
+		case GFGDataType::NORM32_2:
+		case GFGDataType::UNORM8_2:
+		case GFGDataType::UNORM16_2:
+		case GFGDataType::UNORM32_2:
+			return StreamToDoubles(uv, uvStride, data, stride, type, count);
+		case GFGDataType::QUADRUPLE_2:
+			return false;
+		case GFGDataType::NORM_2_10_10_10:
+			UnpackElements(uv, uvStride, data, stride, 2, count,
+						   GFGConversions::Int2_10_10_10ToDoubles);
+			break;
+		case GFGDataType::UNORM_2_10_10_10:
+			UnpackElements(uv, uvStride, data, stride, 2, count,
+						   GFGConversions::UInt2_10_10_10ToDoubles);
+			break;
+		default:
+			return false;
+	}
+	return true;
+}
+
 bool GFGWeight::IsCompatible(GFGDataType t, unsigned int maxWeightInfluence)
 {
 	switch(t)
@@ -910,6 +1316,119 @@ bool GFGWeight::UnConvertData(double weight[],
 	return true;
 }
 
+bool GFGWeight::ConvertData(uint8_t vertexData[], const GFGVertexComponent& component,
+							const double weight[], size_t weightStride,
+							unsigned int maxWeightInfluence, size_t count)
+{
+	GFGDataType type = component.dataType;
+	if(!IsCompatible(type, maxWeightInfluence)) return false;
+	if(maxWeightInfluence == 0) return true;
+
+	// Only the first "maxWeightInfluence" components are written
+	uint8_t* data = ComponentData(vertexData, component);
+	size_t stride = ComponentStride(component);
+	switch(type)
+	{
+		case GFGDataType::HALF_1:
+		case GFGDataType::HALF_2:
+		case GFGDataType::HALF_3:
+		case GFGDataType::HALF_4:
+		case GFGDataType::FLOAT_1:
+		case GFGDataType::FLOAT_2:
+		case GFGDataType::FLOAT_3:
+		case GFGDataType::FLOAT_4:
+		case GFGDataType::DOUBLE_1:
+		case GFGDataType::DOUBLE_2:
+		case GFGDataType::DOUBLE_3:
+		case GFGDataType::DOUBLE_4:
+			return DoublesToStream(data, stride, WithComponents(type, maxWeightInfluence),
+								   weight, weightStride, count);
+		case GFGDataType::QUADRUPLE_1:
+		case GFGDataType::QUADRUPLE_2:
+		case GFGDataType::QUADRUPLE_3:
+		case GFGDataType::QUADRUPLE_4:
+			return false;
+		case GFGDataType::UNORM8_1:
+		case GFGDataType::UNORM8_2:
+		case GFGDataType::UNORM8_3:
+		case GFGDataType::UNORM8_4:
+		case GFGDataType::UNORM8_4_4:
+			BlockToData(data, stride, weight, weightStride, maxWeightInfluence, count, DoublesToNorm<uint8_t>);
+			break;
+		case GFGDataType::UNORM16_1:
+		case GFGDataType::UNORM16_2:
+		case GFGDataType::UNORM16_3:
+		case GFGDataType::UNORM16_4:
+		case GFGDataType::UNORM16_2_4:
+			BlockToData(data, stride, weight, weightStride, maxWeightInfluence, count, DoublesToNorm<uint16_t>);
+			break;
+		case GFGDataType::UNORM32_1:
+		case GFGDataType::UNORM32_2:
+		case GFGDataType::UNORM32_3:
+		case GFGDataType::UNORM32_4:
+			BlockToData(data, stride, weight, weightStride, maxWeightInfluence, count, DoublesToNorm<uint32_t>);
+			break;
+		default:
+			return false;
+	}
+	return true;
+}
+
+bool GFGWeight::UnConvertData(double weight[], size_t weightStride,
+							  unsigned int &maxWeightInfluence,
+							  const uint8_t vertexData[], const GFGVertexComponent& component,
+							  size_t count)
+{
+	const uint8_t* data = ComponentData(vertexData, component);
+	size_t stride = ComponentStride(component);
+	GFGDataType type = component.dataType;
+	switch(type)
+	{
+		case GFGDataType::HALF_1:
+		case GFGDataType::HALF_2:
+		case GFGDataType::HALF_3:
+		case GFGDataType::HALF_4:
+		case GFGDataType::FLOAT_1:
+		case GFGDataType::FLOAT_2:
+		case GFGDataType::FLOAT_3:
+		case GFGDataType::FLOAT_4:
+		case GFGDataType::DOUBLE_1:
+		case GFGDataType::DOUBLE_2:
+		case GFGDataType::DOUBLE_3:
+		case GFGDataType::DOUBLE_4:
+		case GFGDataType::UNORM8_1:
+		case GFGDataType::UNORM8_2:
+		case GFGDataType::UNORM8_3:
+		case GFGDataType::UNORM8_4:
+		case GFGDataType::UNORM16_1:
+		case GFGDataType::UNORM16_2:
+		case GFGDataType::UNORM16_3:
+		case GFGDataType::UNORM16_4:
+		case GFGDataType::UNORM32_1:
+		case GFGDataType::UNORM32_2:
+		case GFGDataType::UNORM32_3:
+		case GFGDataType::UNORM32_4:
+			maxWeightInfluence = Components(type);
+			return StreamToDoubles(weight, weightStride, data, stride, type, count);
+		case GFGDataType::QUADRUPLE_1:
+		case GFGDataType::QUADRUPLE_2:
+		case GFGDataType::QUADRUPLE_3:
+		case GFGDataType::QUADRUPLE_4:
+			return false;
+		case GFGDataType::UNORM16_2_4:
+			maxWeightInfluence = 8;
+			DataToBlock(weight, weightStride, data, stride, maxWeightInfluence, count, NormToDoubles<uint16_t>);
+			break;
+		case GFGDataType::UNORM8_4_4:
+			maxWeightInfluence = 16;
+			DataToBlock(weight, weightStride, data, stride, maxWeightInfluence, count, NormToDoubles<uint8_t>);
+			break;
+		default:
+			return false;
+	}
+	return true;
+}
+
 bool GFGWeightIndex::IsCompatible(GFGDataType t, unsigned int maxWeightInfluence)
 {
 	switch(t)
@@ -1160,6 +1679,99 @@ bool GFGWeightIndex::UnConvertData(unsigned int wIndex[],
 	return true;
 }
 
+bool GFGWeightIndex::ConvertData(uint8_t vertexData[], const GFGVertexComponent& component,
+								 const unsigned int wIndex[], size_t wIndexStride,
+								 unsigned int maxWeightInfluence, size_t count)
+{
+	GFGDataType type = component.dataType;
+	if(!IsCompatible(type, maxWeightInfluence)) return false;
+	if(maxWeightInfluence == 0) return true;
+
+	// Only the first "maxWeightInfluence" components are written
+	uint8_t* data = ComponentData(vertexData, component);
+	size_t stride = ComponentStride(component);
+	switch(type)
+	{
+		case GFGDataType::UINT8_1:
+		case GFGDataType::UINT8_2:
+		case GFGDataType::UINT8_3:
+		case GFGDataType::UINT8_4:
+		case GFGDataType::UINT8_4_4:
+			BlockToData(data, stride, wIndex, wIndexStride, maxWeightInfluence, count, Cast<uint8_t, unsigned int>);
+			break;
+		case GFGDataType::UINT16_1:
+		case GFGDataType::UINT16_2:
+		case GFGDataType::UINT16_3:
+		case GFGDataType::UINT16_4:
+		case GFGDataType::UINT16_2_4:
+			BlockToData(data, stride, wIndex, wIndexStride, maxWeightInfluence, count, Cast<uint16_t, unsigned int>);
+			break;
+		case GFGDataType::UINT32_1:
+		case GFGDataType::UINT32_2:
+		case GFGDataType::UINT32_3:
+		case GFGDataType::UINT32_4:
+			BlockToData(data, stride, wIndex, wIndexStride, maxWeightInfluence, count, Cast<uint32_t, unsigned int>);
+			break;
+		case GFGDataType::UNORM_2_10_10_10:
+			PackElements(data, stride, wIndex, wIndexStride, maxWeightInfluence, count,
+						 GFGConversions::UIntsToUInt2_10_10_10);
+			break;
+		default:
+			return false;
+	}
+	return true;
+}
+
+bool GFGWeightIndex::UnConvertData(unsigned int wIndex[], size_t wIndexStride,
+								   unsigned int &maxWeightInfluence,
+								   const uint8_t vertexData[], const GFGVertexComponent& component,
+								   size_t count)
+{
+	const uint8_t* data = ComponentData(vertexData, component);
+	size_t stride = ComponentStride(component);
+	GFGDataType type = component.dataType;
+	switch(type)
+	{
+		case GFGDataType::UINT8_1:
+		case GFGDataType::UINT8_2:
+		case GFGDataType::UINT8_3:
+		case GFGDataType::UINT8_4:
+			maxWeightInfluence = Components(type);
+			DataToBlock(wIndex, wIndexStride, data, stride, maxWeightInfluence, count, Cast<unsigned int, uint8_t>);
+			break;
+		case GFGDataType::UINT16_1:
+		case GFGDataType::UINT16_2:
+		case GFGDataType::UINT16_3:
+		case GFGDataType::UINT16_4:
+			maxWeightInfluence = Components(type);
+			DataToBlock(wIndex, wIndexStride, data, stride, maxWeightInfluence, count, Cast<unsigned int, uint16_t>);
+			break;
+		case GFGDataType::UINT32_1:
+		case GFGDataType::UINT32_2:
+		case GFGDataType::UINT32_3:
+		case GFGDataType::UINT32_4:
+			maxWeightInfluence = Components(type);
+			DataToBlock(wIndex, wIndexStride, data, stride, maxWeightInfluence, count, Cast<unsigned int, uint32_t>);
+			break;
+		case GFGDataType::UNORM_2_10_10_10:
+			maxWeightInfluence = 3;
+			UnpackElements(wIndex, wIndexStride, data, stride, maxWeightInfluence, count,
+						   GFGConversions::UInt2_10_10_10ToUInts);
+			break;
+		case GFGDataType::UINT16_2_4:
+			maxWeightInfluence = 8;
+			DataToBlock(wIndex, wIndexStride, data, stride, maxWeightInfluence, count, Cast<unsigned int, uint16_t>);
+			break;
+		case GFGDataType::UINT8_4_4:
+			maxWeightInfluence = 16;
+			DataToBlock(wIndex, wIndexStride, data, stride, maxWeightInfluence, count, Cast<unsigned int, uint8_t>);
+			break;
+		default:
+			return false;
+	}
+	return true;
+}
+
 bool GFGColor::IsCompatible(GFGDataType t)
 {
 	switch(t)
@@ -1285,3 +1897,70 @@ bool GFGColor::UnConvertData(double color[3], size_t dataSize,
 	}
 	return true;
 }
+
+bool GFGColor::ConvertData(uint8_t vertexData[], const GFGVertexComponent& component,
+						   const double color[], size_t colorStride, size_t count)
+{
+	uint8_t* data = ComponentData(vertexData, component);
+	size_t stride = ComponentStride(component);
+	GFGDataType type = component.dataType;
+	switch(type)
+	{
+		case GFGDataType::HALF_3:
+		case GFGDataType::FLOAT_3:
+		case GFGDataType::DOUBLE_3:
+			return DoublesToStream(data, stride, type, color, colorStride, count);
+		case GFGDataType::QUADRUPLE_3:
+			return false;
+		case GFGDataType::UNORM8_3:
+			BlockToData(data, stride, color, colorStride, 3, count, DoublesToNorm<uint8_t>);
+			break;
+		case GFGDataType::UNORM16_3:
+			BlockToData(data, stride, color, colorStride, 3, count, DoublesToNorm<uint16_t>);
+			break;
+		case GFGDataType::UNORM32_3:
+			BlockToData(data, stride, color, colorStride, 3, count, DoublesToNorm<uint32_t>);
+			break;
+		case GFGDataType::UNORM_2_10_10_10:
+			PackElements(data, stride, color, colorStride, 3, count,
+						 GFGConversions::DoublesToUInt2_10_10_10);
+			break;
+		case GFGDataType::UINT_10F_11F_11F:
+			// Packed float conversion is not implemented
+			return false;
+		default:
+			return false;
+	}
+	return true;
+}
+
+bool GFGColor::UnConvertData(double color[], size_t colorStride,
+							 const uint8_t vertexData[], const GFGVertexComponent& component,
+							 size_t count)
+{
+	const uint8_t* data = ComponentData(vertexData, component);
+	size_t stride = ComponentStride(component);
+	GFGDataType type = component.dataType;
+	switch(type)
+	{
+		case GFGDataType::HALF_3:
+		case GFGDataType::FLOAT_3:
+		case GFGDataType::DOUBLE_3:
+		case GFGDataType::UNORM8_3:
+		case GFGDataType::UNORM16_3:
+		case GFGDataType::UNORM32_3:
+			return StreamToDoubles(color, colorStride, data, stride, type, count);
+		case GFGDataType::QUADRUPLE_3:
+			return false;
+		case GFGDataType::UNORM_2_10_10_10:
+			UnpackElements(color, colorStride, data, stride, 3, count,
+						   GFGConversions::UInt2_10_10_10ToDoubles);
+			break;
+		case GFGDataType::UINT_10F_11F_11F:
+			// Packed float conversion is not implemented
+			return false;
+		default:
+			return false;
+	}
+	return true;
+}
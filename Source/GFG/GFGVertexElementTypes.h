@@ -25,6 +25,14 @@ GFGColor Namespace
 	Weight
 	Weight Index
 
+	Bulk versions convert "count" elements in a single call. i'th element is
+	read from (or written to) "elements + i * elementStride" (stride is in
+	elements, not bytes) and written to (or read from) the vertex data at
+	"vertexData + startOffset + internalOffset + i * stride" of the component
+	(zero stride is tightly packed). UINT_10F_11F_11F colors are not supported.
+	Half, float and double components use the stream conversion kernels,
+	other types are converted in blocks.
+
 
 For License refer to:
 https://github.com/yalcinerbora/GFGFileFormat/blob/master/LICENSE
@@ -34,6 +42,7 @@ https://github.com/yalcinerbora/GFGFileFormat/blob/master/LICENSE
 #define __GFG_VERTEXELEMENTTYPES_H__
 
 #include "GFGEnumerations.h"
+#include "GFGMeshHeader.h"
 
 namespace GFGPosition
 {
@@ -42,6 +51,13 @@ namespace GFGPosition
 							const double pos[3], GFGDataType type);
 	bool		UnConvertData(double pos[3], size_t dataSize,
 							  const uint8_t data[], GFGDataType type);
+
+	// Bulk
+	bool		ConvertData(uint8_t vertexData[], const GFGVertexComponent&,
+							const double pos[], size_t posStride, size_t count);
+	bool		UnConvertData(double pos[], size_t posStride,
+							  const uint8_t vertexData[], const GFGVertexComponent&,
+							  size_t count);
 };
 
 namespace GFGNormal
@@ -55,6 +71,13 @@ namespace GFGNormal
 	bool		UnConvertData(double normal[3], size_t dataSize,
 							  const uint8_t data[],
 							  GFGDataType type);
+
+	// Bulk
+	bool		ConvertData(uint8_t vertexData[], const GFGVertexComponent&,
+							const double normal[], size_t normalStride, size_t count);
+	bool		UnConvertData(double normal[], size_t normalStride,
+							  const uint8_t vertexData[], const GFGVertexComponent&,
+							  size_t count);
 };
 
 namespace GFGTangent
@@ -65,6 +88,12 @@ namespace GFGTangent
 							GFGDataType type,
 							const double normal[3] = nullptr,
 							const double bitangent[3] = nullptr);
+
+	// Bulk (normals and bitangents have the same stride, required by CUSTOM_TANG_H_2N)
+	bool		ConvertData(uint8_t vertexData[], const GFGVertexComponent&,
+							const double tangent[], size_t tangentStride, size_t count,
+							const double normal[] = nullptr,
+							const double bitangent[] = nullptr);
 };
 
 namespace GFGBinormal
@@ -75,6 +104,10 @@ namespace GFGBinormal
 							GFGDataType type,
 							const double tangent[3] = nullptr,
 							const double normal[3] = nullptr);
+
+	// Bulk
+	bool		ConvertData(uint8_t vertexData[], const GFGVertexComponent&,
+							const double bitangent[], size_t bitangentStride, size_t count);
 };
 
 namespace GFGUV
@@ -85,6 +118,13 @@ namespace GFGUV
 							GFGDataType type);
 	bool		UnConvertData(double uv[2], size_t dataSize,
 							  const uint8_t data[], GFGDataType type);
+
+	// Bulk
+	bool		ConvertData(uint8_t vertexData[], const GFGVertexComponent&,
+							const double uv[], size_t uvStride, size_t count);
+	bool		UnConvertData(double uv[], size_t uvStride,
+							  const uint8_t vertexData[], const GFGVertexComponent&,
+							  size_t count);
 };
 
 namespace GFGWeight
@@ -98,6 +138,15 @@ namespace GFGWeight
 							  size_t dataSize,
 							  const uint8_t data[],
 							  GFGDataType type);
+
+	// Bulk
+	bool		ConvertData(uint8_t vertexData[], const GFGVertexComponent&,
+							const double weight[], size_t weightStride,
+							unsigned int maxWeightInfluence, size_t count);
+	bool		UnConvertData(double weight[], size_t weightStride,
+							  unsigned int &maxWeightInfluence,
+							  const uint8_t vertexData[], const GFGVertexComponent&,
+							  size_t count);
 };
 
 namespace GFGWeightIndex
@@ -111,6 +160,15 @@ namespace GFGWeightIndex
 							  size_t dataSize,
 							  const uint8_t data[],
 							  GFGDataType type);
+
+	// Bulk
+	bool		ConvertData(uint8_t vertexData[], const GFGVertexComponent&,
+							const unsigned int wIndex[], size_t wIndexStride,
+							unsigned int maxWeightInfluence, size_t count);
+	bool		UnConvertData(unsigned int wIndex[], size_t wIndexStride,
+							  unsigned int &maxWeightInfluence,
+							  const uint8_t vertexData[], const GFGVertexComponent&,
+							  size_t count);
 };
 
 namespace GFGColor
@@ -122,5 +180,12 @@ namespace GFGColor
 	bool		UnConvertData(double color[3], size_t dataSize,
 							  const uint8_t data[],
 							  GFGDataType type);
+
+	// Bulk
+	bool		ConvertData(uint8_t vertexData[], const GFGVertexComponent&,
+							const double color[], size_t colorStride, size_t count);
+	bool		UnConvertData(double color[], size_t colorStride,
+							  const uint8_t vertexData[], const GFGVertexComponent&,
+							  size_t count);
 };
 #endif //__GFG_VERTEXELEMENTTYPES_H__
\ No newline at end of file